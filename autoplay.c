@@ -0,0 +1,105 @@
+/** @file   autoplay.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Computer player
+ */
+
+#include "system.h"
+#include "autoplay.h"
+#include "wall.h"
+#include "character.h"
+#include "input.h"
+#include "hal.h"
+
+
+static const uint8_t DIRECTION_INPUTS[] =    // Navswitch input of each WALL_DIRECTION_t
+{
+	[NORTH] = INPUT_NORTH,
+	[SOUTH] = INPUT_SOUTH,
+	[WEST]  = INPUT_WEST,
+	[EAST]  = INPUT_EAST
+};
+
+static bool    active = false;
+static uint8_t period;                       // Game ticks per move
+static uint8_t wait;                         // Game ticks until the next move
+
+
+/*  Start playing the current game
+ *  @param move_period: game ticks per move, 1 moves on every tick
+ */
+void autoplay_start(uint8_t move_period)
+{
+	period = (move_period < 1) ? 1 : move_period;
+	wait   = period;
+	active = true;
+}
+
+
+/*  Stop playing, presses are left alone again
+ */
+void autoplay_stop(void)
+{
+	active = false;
+}
+
+
+/*  Returns true while the computer is playing
+ */
+bool autoplay_active_p(void)
+{
+	return active;
+}
+
+
+/*  Returns the move back to the start cell, away from the edges walls spawn on
+ *  @return WALL_DIRECTION_t, 0 if at the start cell
+ */
+static uint8_t home_direction(const CharacterInfoStruct *character)
+{
+	if (character->x != DEFAULT_X)
+	{
+		return (character->x < DEFAULT_X) ? EAST : WEST;
+	}
+
+	if (character->y != DEFAULT_Y)
+	{
+		return (character->y < DEFAULT_Y) ? SOUTH : NORTH;
+	}
+
+	return 0;
+}
+
+
+/*  Replace this game tick's presses with the computer's move
+ *  @brief: one step of the way out of the next wall's path (wall_escape()),
+ *          or back to the start cell while no wall is coming.
+ *          No presses on the ticks in between
+ */
+void autoplay_update(void)
+{
+	const CharacterInfoStruct *character = get_character_info();
+	uint8_t                   escape, direction = 0;
+
+	if (!active)
+	{
+		return;
+	}
+
+	if (--wait == 0)
+	{
+		wait   = period;
+		escape = wall_escape(character->x, character->y);
+
+		if (escape == WALL_ESCAPE_CLEAR)
+		{
+			direction = home_direction(character);
+		}
+		else if (WALL_ESCAPE_MOVES(escape) > 0)
+		{
+			direction = WALL_ESCAPE_DIRECTION(escape);
+		}
+	}
+
+	input_presses_set(direction ? BIT(DIRECTION_INPUTS[direction]) : 0);
+}
@@ -0,0 +1,47 @@
+/** @file   autoplay.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Computer player
+ *          Plays the title menu's demo game on the board and the host
+ *          simulations' "auto" policy (host/sim.c). Every decision is one
+ *          lookup, wall_escape() reads the shortest way out of the path of the
+ *          next wall from the table host/wallgen.c builds for every wall
+ *          variant and player cell. It costs the same every game tick, so it
+ *          runs in control_task alongside character_update().
+ *          The player moves at most once every move period (game ticks),
+ *          one step toward the hole, stays put while in it and walks
+ *          back to the start cell (away from the spawn edges) between walls.
+ */
+
+#ifndef AUTOPLAY_H
+#define AUTOPLAY_H
+
+#include "system.h"
+
+#define AUTOPLAY_DEMO_PERIOD    20       // Game ticks per move of the demo (5 moves/s at 100 Hz)
+
+
+/*  Start playing the current game
+ *  @param move_period: game ticks per move, 1 moves on every tick
+ */
+void autoplay_start(uint8_t move_period);
+
+
+/*  Stop playing, presses are left alone again
+ */
+void autoplay_stop(void);
+
+
+/*  Returns true while the computer is playing
+ */
+bool autoplay_active_p(void);
+
+
+/*  Replace this game tick's presses with the computer's move
+ *  @brief: call once per game tick after input_update(),
+ *          does nothing unless playing
+ */
+void autoplay_update(void);
+
+
+#endif
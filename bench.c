@@ -0,0 +1,303 @@
+/** @file   bench.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Microbenchmarks of the game hot paths
+ *          Built for the board (bench.out, run in simavr: exact CPU cycles per
+ *          call) and for the host (host/bench: ns per call). Each benchmark
+ *          has a setup that runs untimed before every call, the cost of
+ *          reading the clock is measured with an empty call and subtracted.
+ *          On the board every call runs with interrupts off.
+ *
+ *  Output is one tab separated line per benchmark:
+ *      <function> <unit> <calls> <per call>
+ *  `make bench` writes bench_avr.tsv and bench_host.tsv
+ */
+
+#include "system.h"
+#include "hal.h"
+#include "input.h"
+#include "character.h"
+#include "wall.h"
+#include "render.h"
+#include "game_manager.h"
+#include "sound.h"
+#include "mixer.h"
+#include "scroll.h"
+#include "autoplay.h"
+
+#ifdef __AVR__
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "avr_mcu_section.h"
+
+#define BENCH_CALLS    256                     // Calls per benchmark (cycle counts are exact)
+#define BENCH_UNIT     "cycles"
+
+typedef uint16_t bench_tick_t;                 // Timer1 without prescaler, calls must take < 65536 cycles
+typedef uint32_t bench_total_t;
+
+// Lines written to GPIOR0 are printed by simavr
+AVR_MCU(F_CPU, "atmega32u2");
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+#else
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_CALLS    100000
+#define BENCH_UNIT     "ns"
+
+typedef uint64_t bench_tick_t;
+typedef uint64_t bench_total_t;
+#endif
+
+#define BENCH_SEED             0xACE1
+#define BENCH_WALLS            2               // Live walls in move_walls (as many as THREE_LIVES has)
+#define DISPLAY_UPDATE_RATE    300             // Same as game.c
+#define MESSAGE_RATE           20
+
+
+// Benchmark, setup() prepares the state run() is timed in
+typedef struct
+{
+	const char *name;
+	void       (*setup)(void);
+	void       (*run)(void);
+} BenchStruct;
+
+
+static MixerStruct mixer;
+static uint16_t    seed = BENCH_SEED;
+
+
+/*  Returns clock, cycles on the board and ns on the host
+ */
+static inline bench_tick_t bench_clock(void)
+{
+#ifdef __AVR__
+	return TCNT1;
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000u + now.tv_nsec;
+#endif
+}
+
+
+/*  Setups
+ */
+static void nothing(void)
+{
+}
+
+
+static void walls_reset(void)
+{
+	wall_init(seed++);
+}
+
+
+static void walls_fill(void)
+{
+	uint8_t index;
+
+	wall_init(seed++);
+
+	for (index = 0; index < BENCH_WALLS; index++)
+	{
+		wall_create(WALL_FULL_SPEED);
+	}
+}
+
+
+static void scroll_reset(void)
+{
+	scroll_message(MESSAGE_GAME_MODE_PROMPT);      // Next update draws a frame
+}
+
+
+static void player_reset(void)
+{
+	character_init(3);
+	toggle_stun(false);
+}
+
+
+/*  East press in this tick's snapshot, from the start cell with no walls
+ *  @brief: the navswitch can't be pressed from code on the board, the press
+ *          is put in the snapshot after input_update() as replay playback does
+ */
+static void move_press_reset(void)
+{
+	walls_reset();
+	player_reset();
+	input_update();
+	input_presses_set(BIT(INPUT_EAST));
+}
+
+
+static void autoplay_reset(void)
+{
+	walls_fill();
+	player_reset();
+	autoplay_start(1);                             // Decides on every call
+}
+
+
+/*  Benchmarked calls (wrappers for functions that take arguments)
+ */
+static void wall_create_run(void)
+{
+	wall_create(WALL_FULL_SPEED);
+}
+
+
+static void move_walls_run(void)
+{
+	move_walls();
+}
+
+
+static void wall_at_run(void)
+{
+	wall_at(DEFAULT_X, DEFAULT_Y);
+}
+
+
+static void move_east_run(void)
+{
+	move_east();
+}
+
+
+static void mixer_sample_run(void)
+{
+	mixer_sample(&mixer);
+}
+
+
+static const BenchStruct BENCHES[] =
+{
+	{ "wall_create",      walls_reset,       wall_create_run  },
+	{ "move_walls",       walls_fill,        move_walls_run   },
+	{ "wall_at",          walls_fill,        wall_at_run      },
+	{ "check_collisions", player_reset,      check_collisions },
+	{ "character_update", move_press_reset,  character_update },
+	{ "autoplay_update",  autoplay_reset,    autoplay_update  },
+	{ "move_east",        player_reset,      move_east_run    },
+	{ "input_sample",     nothing,           input_sample     },
+	{ "render_update",    render_invalidate, render_update    },
+	{ "scroll_update",    scroll_reset,      scroll_update    },
+	{ "sound_update",     nothing,           sound_update     },
+	{ "mixer_sample",     nothing,           mixer_sample_run }
+};
+
+
+/*  Returns total clock of BENCH_CALLS calls of a benchmark
+ */
+static bench_total_t bench_time(const BenchStruct *bench)
+{
+	bench_total_t total = 0;
+	uint32_t      call;
+
+	for (call = 0; call < BENCH_CALLS; call++)
+	{
+		bench_tick_t start;
+
+		bench->setup();
+		start  = bench_clock();
+		bench->run();
+		total += (bench_tick_t)(bench_clock() - start);
+	}
+
+	return total;
+}
+
+
+/*  Prints result line of a benchmark
+ */
+#ifdef __AVR__
+static void bench_print_string(const char *string)
+{
+	while (*string)
+	{
+		GPIOR0 = *string++;
+	}
+}
+
+
+static void bench_print_number(uint32_t value)
+{
+	char    digits[11];
+	uint8_t length = 0;
+
+	do
+	{
+		digits[length++] = '0' + value % 10;
+		value           /= 10;
+	} while (value);
+
+	while (length)
+	{
+		GPIOR0 = digits[--length];
+	}
+}
+
+
+static void bench_print(const char *name, bench_total_t total)
+{
+	bench_print_string(name);
+	bench_print_string("\t" BENCH_UNIT "\t");
+	bench_print_number(BENCH_CALLS);
+	GPIOR0 = '\t';
+	bench_print_number(total / BENCH_CALLS);
+	GPIOR0 = '\n';
+}
+#else
+static void bench_print(const char *name, bench_total_t total)
+{
+	printf("%s\t" BENCH_UNIT "\t%u\t%.1f\n", name, BENCH_CALLS, (double)total / BENCH_CALLS);
+}
+#endif
+
+
+int main(void)
+{
+	const BenchStruct *bench;
+	bench_total_t     overhead, total;
+	BenchStruct       empty = { "", nothing, nothing };
+
+	hal_init(DISPLAY_UPDATE_RATE);
+	scroll_init(MESSAGE_RATE, DISPLAY_UPDATE_RATE);
+	game_init(MESSAGE_RATE);
+	sound_init();
+
+	game_mode_set(THREE_LIVES);             // Two walls and a hit that never ends the game (see player_reset)
+	game_start();
+
+	mixer_init(&mixer);
+	mixer.step[SOUND_MUSIC_VOICE]  = mixer_note_step(69);
+	mixer.step[SOUND_EFFECT_VOICE] = mixer_note_step(76);
+
+#ifdef __AVR__
+	cli();                                  // Timed calls are not interrupted (display scan, tone)
+	TCCR1A = 0;
+	TCCR1B = BIT(CS10);                     // Count CPU cycles
+#endif
+
+	overhead = bench_time(&empty);
+
+	for (bench = BENCHES; bench < BENCHES + ARRAY_SIZE(BENCHES); bench++)
+	{
+		total = bench_time(bench);
+		bench_print(bench->name, (total > overhead) ? total - overhead : 0);
+	}
+
+#ifdef __AVR__
+	sleep_enable();
+	sleep_cpu();                            // Sleeping with interrupts off stops simavr
+#endif
+	return 0;
+}
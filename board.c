@@ -0,0 +1,99 @@
+/** @file   board.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Game-state bitboard
+ */
+
+#include <string.h>
+#include "system.h"
+#include "board.h"
+#include "wall.h"
+#include "game_state.h"
+
+
+/*  Removes walls from board, player is kept
+ */
+void board_walls_clear(void)
+{
+	BoardStruct *board = game_state_board_edit();
+
+	memset(board->walls, 0, sizeof(board->walls));
+}
+
+
+/*  Adds a wall to the walls already on the board
+ *  @param wall: wall to place, OUT_OF_BOUNDS walls add nothing
+ *  @brief: COLUMN walls fill one byte, ROW walls set the same bit in every byte
+ */
+void board_wall_add(const WallStruct *wall)
+{
+	BoardStruct *board = game_state_board_edit();
+	uint8_t     x;
+
+	switch (wall->wall_type)
+	{
+	case COLUMN:
+		board->walls[wall->pos] |= wall->bit_data & BOARD_COLUMN_MASK;
+		break;
+
+	case ROW:
+		for (x = 0; x < BOARD_WIDTH; x++)
+		{
+			board->walls[x] |= ((wall->bit_data >> x) & 1) << wall->pos;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+
+/*  Returns wall cells of a column (bit n = row n)
+ *  @param x: column
+ */
+uint8_t board_column_get(uint8_t x)
+{
+	const BoardStruct *board = &game_state_get()->board;
+
+	return (x < BOARD_WIDTH) ? board->walls[x] : 0;
+}
+
+
+/*  Moves player on board
+ *  @param x: column, y: row
+ */
+void board_player_set(uint8_t x, uint8_t y)
+{
+	BoardStruct *board = game_state_board_edit();
+
+	board->player_column   = x;
+	board->player_row_mask = BIT(y);
+}
+
+
+/*  Returns player cell of a column (bit n = row n), 0 if the player is in another column
+ *  @param x: column
+ */
+uint8_t board_player_column_get(uint8_t x)
+{
+	const BoardStruct *board = &game_state_get()->board;
+
+	return (x == board->player_column) ? board->player_row_mask : 0;
+}
+
+
+/*  Returns true if cell is occupied by a wall (or off the board)
+ *  @param x: column, y: row
+ */
+bool board_blocked_p(uint8_t x, uint8_t y)
+{
+	const BoardStruct *board = &game_state_get()->board;
+
+	if ((x >= BOARD_WIDTH) || (y >= BOARD_HEIGHT))
+	{
+		return true;
+	}
+
+	return (board->walls[x] & BIT(y)) != 0;
+}
@@ -0,0 +1,65 @@
+/** @file   board.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Game-state bitboard
+ *          Walls and player as bitmasks, one byte per column (bit n = row n),
+ *          so collision and blocked-move checks don't touch the display
+ */
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "system.h"
+#include "wall.h"
+
+#define BOARD_WIDTH          LEDMAT_COLS_NUM
+#define BOARD_HEIGHT         LEDMAT_ROWS_NUM
+#define BOARD_COLUMN_MASK    (BIT(BOARD_HEIGHT) - 1)
+
+
+/* Bitboard, part of GameStateStruct (see game_state.h)
+ */
+typedef struct
+{
+	uint8_t walls[BOARD_WIDTH];           // Wall cells of each column
+	uint8_t player_column;                // Column the player is in
+	uint8_t player_row_mask;              // BIT(row) of the player
+} BoardStruct;
+
+
+/*  Removes walls from board, player is kept
+ */
+void board_walls_clear(void);
+
+
+/*  Adds a wall to the walls already on the board
+ *  @param wall: wall to place, OUT_OF_BOUNDS walls add nothing
+ */
+void board_wall_add(const WallStruct *wall);
+
+
+/*  Returns wall cells of a column (bit n = row n)
+ *  @param x: column
+ */
+uint8_t board_column_get(uint8_t x);
+
+
+/*  Moves player on board
+ *  @param x: column, y: row
+ */
+void board_player_set(uint8_t x, uint8_t y);
+
+
+/*  Returns player cell of a column (bit n = row n), 0 if the player is in another column
+ *  @param x: column
+ */
+uint8_t board_player_column_get(uint8_t x);
+
+
+/*  Returns true if cell is occupied by a wall (or off the board)
+ *  @param x: column, y: row
+ */
+bool board_blocked_p(uint8_t x, uint8_t y);
+
+
+#endif
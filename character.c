@@ -5,11 +5,10 @@
  */
 
 #include "character.h"
-#include "display.h"
-#include "navswitch.h"
-
-// Character properties
-static CharacterInfoStruct character_info;
+#include "board.h"
+#include "render.h"
+#include "input.h"
+#include "game_state.h"
 
 
 /* Initialisation for character module
@@ -19,25 +18,19 @@ static CharacterInfoStruct character_info;
  */
 void character_init(uint8_t life_count)
 {
-	character_info = (CharacterInfoStruct){
-		.x = DEFAULT_X, .y = DEFAULT_Y, .lives = life_count
-	};
-
-	character_enable();
-
-	if (get_stun_condition())             //Prevent character being stunned on respawn
-	{
-		toggle_stun(false);
-	}
+	game_state_lives_set(life_count);
+	game_state_player_move(DEFAULT_X, DEFAULT_Y);
+	game_state_stun_set(false);           //Prevent character being stunned on respawn
+	render_invalidate();
 }
 
 
 /*  Return current character information
- *  @return CharacterInfoStruct with coordinates and number of lives
+ *  @return CharacterInfoStruct with coordinates and number of lives (read only)
  */
-CharacterInfoStruct get_character_info(void)
+const CharacterInfoStruct *get_character_info(void)
 {
-	return character_info;
+	return &game_state_get()->character;
 }
 
 
@@ -46,7 +39,7 @@ CharacterInfoStruct get_character_info(void)
  */
 bool get_stun_condition()
 {
-	return character_info.is_stunned;
+	return game_state_get()->character.is_stunned;
 }
 
 
@@ -55,7 +48,7 @@ bool get_stun_condition()
  */
 void toggle_stun(bool stun_set)
 {
-	character_info.is_stunned = stun_set;
+	game_state_stun_set(stun_set);
 }
 
 
@@ -64,24 +57,10 @@ void toggle_stun(bool stun_set)
  */
 bool decrease_character_lives()
 {
-	character_info.lives--;
-	return(character_info.lives == 0);
-}
-
-
-/* Turns dipslay state for character off
- */
-void character_disable()
-{
-	display_pixel_set(character_info.x, character_info.y, false);
-}
+	uint8_t lives = game_state_get()->character.lives - 1;
 
-
-/* Turns display state for character only
- */
-void character_enable()
-{
-	display_pixel_set(character_info.x, character_info.y, true);
+	game_state_lives_set(lives);
+	return(lives == 0);
 }
 
 
@@ -90,12 +69,13 @@ void character_enable()
  */
 bool move_west()
 {
+	const CharacterInfoStruct *character_info = get_character_info();
+
 	// Wont move character off west boundary or into a position already occupied (by a wall)
-	if ((WEST_CHARACTER_BOUNDARY < character_info.x) && !display_pixel_get(character_info.x - STEP_SIZE, character_info.y))
+	if ((WEST_CHARACTER_BOUNDARY < character_info->x) && !board_blocked_p(character_info->x - STEP_SIZE, character_info->y))
 	{
-		character_disable();
-		character_info.x -= STEP_SIZE;
-		character_enable();
+		game_state_player_move(character_info->x - STEP_SIZE, character_info->y);
+		render_invalidate();
 
 		return false;
 	}
@@ -109,12 +89,13 @@ bool move_west()
  */
 bool move_east()
 {
+	const CharacterInfoStruct *character_info = get_character_info();
+
 	// Wont move character off east boundary or into a position already occupied (by a wall)
-	if ((EAST_CHARACTER_BOUNDARY > character_info.x) && !display_pixel_get(character_info.x + STEP_SIZE, character_info.y))
+	if ((EAST_CHARACTER_BOUNDARY > character_info->x) && !board_blocked_p(character_info->x + STEP_SIZE, character_info->y))
 	{
-		character_disable();
-		character_info.x += STEP_SIZE;
-		character_enable();
+		game_state_player_move(character_info->x + STEP_SIZE, character_info->y);
+		render_invalidate();
 
 		return false;
 	}
@@ -128,12 +109,13 @@ bool move_east()
  */
 bool move_north()
 {
+	const CharacterInfoStruct *character_info = get_character_info();
+
 	// Wont move character off northern boundary or into a position already occupied (by a wall)
-	if ((NORTH_CHARACTER_BOUNDARY < character_info.y) && !display_pixel_get(character_info.x, character_info.y - STEP_SIZE))
+	if ((NORTH_CHARACTER_BOUNDARY < character_info->y) && !board_blocked_p(character_info->x, character_info->y - STEP_SIZE))
 	{
-		character_disable();
-		character_info.y -= STEP_SIZE;
-		character_enable();
+		game_state_player_move(character_info->x, character_info->y - STEP_SIZE);
+		render_invalidate();
 
 		return false;
 	}
@@ -147,12 +129,13 @@ bool move_north()
  */
 bool move_south()
 {
+	const CharacterInfoStruct *character_info = get_character_info();
+
 	// Wont move character off southern boundary or into a position already occupied (by a wall)
-	if ((SOUTH_CHARACTER_BOUNDARY > character_info.y) && !display_pixel_get(character_info.x, character_info.y + STEP_SIZE))
+	if ((SOUTH_CHARACTER_BOUNDARY > character_info->y) && !board_blocked_p(character_info->x, character_info->y + STEP_SIZE))
 	{
-		character_disable();
-		character_info.y += STEP_SIZE;
-		character_enable();
+		game_state_player_move(character_info->x, character_info->y + STEP_SIZE);
+		render_invalidate();
 
 		return false;
 	}
@@ -166,31 +149,24 @@ bool move_south()
  */
 void character_update()
 {
-	navswitch_update();             // Update navswitch input
-
-	//Restores character state if passed by wall
-	if (!display_pixel_get(character_info.x, character_info.y))
-	{
-		character_enable();
-	}
-
 	// Move character in direction of navswitch input
+	// Every direction pressed since the last tick is applied, so quick taps aren't lost
 	// Doesn't allow movement if character is stunned
-	if (!character_info.is_stunned)
+	if (!get_stun_condition())
 	{
-		if (navswitch_push_event_p(NAVSWITCH_NORTH))
+		if (input_pressed_p(INPUT_NORTH))
 		{
 			move_north();
 		}
-		else if (navswitch_push_event_p(NAVSWITCH_SOUTH))
+		if (input_pressed_p(INPUT_SOUTH))
 		{
 			move_south();
 		}
-		else if (navswitch_push_event_p(NAVSWITCH_EAST))
+		if (input_pressed_p(INPUT_EAST))
 		{
 			move_east();
 		}
-		else if (navswitch_push_event_p(NAVSWITCH_WEST))
+		if (input_pressed_p(INPUT_WEST))
 		{
 			move_west();
 		}
@@ -22,12 +22,13 @@
 #define STEP_SIZE                   1
 
 
-// Character information (lives and position)
+// Character information (lives and position), part of GameStateStruct (see game_state.h)
 typedef struct
 {
-	uint8_t x, y;
-	uint8_t lives;
-	bool    is_stunned;
+	uint8_t x          : 3;
+	uint8_t y          : 3;
+	uint8_t lives      : 2;            // Up to 3
+	uint8_t is_stunned : 1;
 } CharacterInfoStruct;
 
 
@@ -39,9 +40,9 @@ void character_init(uint8_t life_count);
 
 
 /*  Return current character information
- *  @return CharacterInfoStruct with coordinates and number of lives
+ *  @return CharacterInfoStruct with coordinates and number of lives (read only)
  */
-CharacterInfoStruct get_character_info(void);
+const CharacterInfoStruct *get_character_info(void);
 
 
 /*  Returns the stun state of the player
@@ -62,16 +63,6 @@ void toggle_stun(bool stun_set);
 bool decrease_character_lives(void);
 
 
-/* Turns off character
- */
-void character_disable(void);
-
-
-/* Turns display state for character only
- */
-void character_enable(void);
-
-
 /*  Move character STEP_SIZE unit/s in cardinal direction
  *  @return bool true if character moving off boundary else false
  */
@@ -81,7 +72,7 @@ bool move_north(void);
 bool move_south(void);
 
 
-/* Poll navswitch input and move character
+/* Move character from this tick's input snapshot (see input.h)
  *  @brief: Doesn't allow movement is player is stunned
  */
 void character_update(void);
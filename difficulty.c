@@ -0,0 +1,113 @@
+/** @file   difficulty.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Wall speed curves
+ */
+
+#include "system.h"
+#include "difficulty.h"
+#include <avr/pgmspace.h>
+
+#define DIFFICULTY_SEGMENT_MASK    (BIT(DIFFICULTY_SEGMENT_SHIFT) - 1)
+#define WPS(SPEED)                 DIFFICULTY_STEP(SPEED)
+
+
+/* Speed curve, entries are phase steps (see DIFFICULTY_STEP)
+ */
+typedef struct
+{
+	bool     interpolate;                         // Ramp between entries, else hold each entry
+	uint16_t steps[DIFFICULTY_CURVE_LENGTH];
+} DifficultyCurveStruct;
+
+
+static const DifficultyCurveStruct CURVES[DIFFERENT_CURVES] PROGMEM =
+{
+	[CURVE_LINEAR] =              // 1 + t / 20
+	{
+		.interpolate = true,
+		.steps       =
+		{
+			WPS(1.00), WPS(1.13), WPS(1.26), WPS(1.38), WPS(1.51), WPS(1.64), WPS(1.77), WPS(1.90),
+			WPS(2.02), WPS(2.15), WPS(2.28), WPS(2.41), WPS(2.54), WPS(2.66), WPS(2.79), WPS(2.92),
+			WPS(3.05), WPS(3.18), WPS(3.30), WPS(3.43), WPS(3.56), WPS(3.69), WPS(3.82), WPS(3.94),
+			WPS(4.07), WPS(4.20), WPS(4.33), WPS(4.46), WPS(4.58), WPS(4.71), WPS(4.84), WPS(4.97),
+			WPS(5.10), WPS(5.22), WPS(5.35), WPS(5.48), WPS(5.61), WPS(5.74), WPS(5.86), WPS(5.99),
+			WPS(6.12), WPS(6.25), WPS(6.38), WPS(6.50), WPS(6.63), WPS(6.76), WPS(6.89), WPS(7.02),
+			WPS(7.14), WPS(7.27), WPS(7.40), WPS(7.53), WPS(7.66), WPS(7.78), WPS(7.91), WPS(8.04),
+			WPS(8.17), WPS(8.30), WPS(8.42), WPS(8.55), WPS(8.68), WPS(8.81), WPS(8.94), WPS(9.06)
+		}
+	},
+	[CURVE_EXPONENTIAL] =         // 2 ^ (t / 40)
+	{
+		.interpolate = true,
+		.steps       =
+		{
+			WPS( 1.00), WPS( 1.05), WPS( 1.09), WPS( 1.14), WPS( 1.19), WPS( 1.25), WPS( 1.30), WPS( 1.36),
+			WPS( 1.43), WPS( 1.49), WPS( 1.56), WPS( 1.63), WPS( 1.70), WPS( 1.78), WPS( 1.86), WPS( 1.95),
+			WPS( 2.03), WPS( 2.13), WPS( 2.22), WPS( 2.32), WPS( 2.43), WPS( 2.54), WPS( 2.65), WPS( 2.77),
+			WPS( 2.90), WPS( 3.03), WPS( 3.17), WPS( 3.31), WPS( 3.46), WPS( 3.62), WPS( 3.78), WPS( 3.96),
+			WPS( 4.14), WPS( 4.32), WPS( 4.52), WPS( 4.72), WPS( 4.94), WPS( 5.16), WPS( 5.40), WPS( 5.64),
+			WPS( 5.90), WPS( 6.16), WPS( 6.44), WPS( 6.74), WPS( 7.04), WPS( 7.36), WPS( 7.70), WPS( 8.04),
+			WPS( 8.41), WPS( 8.79), WPS( 9.19), WPS( 9.61), WPS(10.04), WPS(10.50), WPS(10.97), WPS(11.47),
+			WPS(11.99), WPS(12.54), WPS(13.10), WPS(13.70), WPS(14.32), WPS(14.97), WPS(15.65), WPS(16.36)
+		}
+	},
+	[CURVE_STEPPED] =             // 1 + floor(t / 20)
+	{
+		.interpolate = false,
+		.steps       =
+		{
+			WPS(1), WPS(1), WPS(1), WPS(1), WPS(1), WPS(1), WPS(1), WPS(1),
+			WPS(2), WPS(2), WPS(2), WPS(2), WPS(2), WPS(2), WPS(2), WPS(2),
+			WPS(3), WPS(3), WPS(3), WPS(3), WPS(3), WPS(3), WPS(3), WPS(3),
+			WPS(4), WPS(4), WPS(4), WPS(4), WPS(4), WPS(4), WPS(4), WPS(4),
+			WPS(5), WPS(5), WPS(5), WPS(5), WPS(5), WPS(5), WPS(5), WPS(5),
+			WPS(6), WPS(6), WPS(6), WPS(6), WPS(6), WPS(6), WPS(6), WPS(7),
+			WPS(7), WPS(7), WPS(7), WPS(7), WPS(7), WPS(7), WPS(7), WPS(8),
+			WPS(8), WPS(8), WPS(8), WPS(8), WPS(8), WPS(8), WPS(8), WPS(9)
+		}
+	}
+};
+
+
+static const DifficultyCurveStruct *curve = &CURVES[CURVE_LINEAR];
+static uint16_t                    ticks  = 0;         // Ticks since start, stops at the last entry
+static uint16_t                    phase  = 0;
+
+
+/*  Restart a speed curve from its first entry
+ *  @param new_curve: curve to follow
+ */
+void difficulty_start(DIFFICULTY_CURVE_t new_curve)
+{
+	curve = &CURVES[(new_curve < DIFFERENT_CURVES) ? new_curve : CURVE_LINEAR];
+	ticks = 0;
+	phase = 0;
+}
+
+
+/*  Advance curve and phase accumulator by one tick
+ *  @return true if the wall should move this tick
+ *  @brief: Between entries the step is interpolated with a multiply and shift
+ */
+bool difficulty_tick(void)
+{
+	uint8_t  segment = ticks >> DIFFICULTY_SEGMENT_SHIFT;
+	uint16_t last    = phase;
+	uint16_t step    = pgm_read_word(&curve->steps[segment]);
+
+	if (segment < DIFFICULTY_CURVE_LENGTH - 1)
+	{
+		if (pgm_read_byte(&curve->interpolate))
+		{
+			int16_t slope = pgm_read_word(&curve->steps[segment + 1]) - step;
+
+			step += ((int32_t)slope * (ticks & DIFFICULTY_SEGMENT_MASK)) >> DIFFICULTY_SEGMENT_SHIFT;
+		}
+		ticks++;
+	}
+
+	phase += step;
+	return phase < last;                          // Wrapped
+}
@@ -0,0 +1,46 @@
+/** @file   difficulty.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Wall speed curves
+ *          Wall movement is driven by a 16 bit phase accumulator advanced every
+ *          tick, the wall moves each time it wraps. The step added each tick
+ *          comes from a per-curve table in flash (interpolated between entries),
+ *          so acceleration is smooth and no division is needed at runtime.
+ */
+
+#ifndef DIFFICULTY_H
+#define DIFFICULTY_H
+
+#include "system.h"
+
+#define DIFFICULTY_TICK_RATE        200     // Rate difficulty_tick() is called in hz
+#define DIFFICULTY_SEGMENT_SHIFT    9       // Curve entries are 2^9 ticks (2.56 s) apart
+#define DIFFICULTY_CURVE_LENGTH     64      // Entries per curve, the last one holds (after ~161 s)
+
+// Phase step for a speed in walls/second (compile time only)
+#define DIFFICULTY_STEP(WALLS_PER_SECOND)    ((uint16_t)((WALLS_PER_SECOND) * 65536.0 / DIFFICULTY_TICK_RATE + 0.5))
+
+
+// Speed curves, see CURVES in difficulty.c
+typedef enum
+{
+	CURVE_LINEAR = 0,           // +1 wall/s every 20 s, continuous
+	CURVE_EXPONENTIAL,          // Doubles every 40 s
+	CURVE_STEPPED,              // +1 wall/s every 20 s in steps (original difficulty)
+	DIFFERENT_CURVES
+} DIFFICULTY_CURVE_t;
+
+
+/*  Restart a speed curve from its first entry
+ *  @param curve: curve to follow
+ */
+void difficulty_start(DIFFICULTY_CURVE_t curve);
+
+
+/*  Advance curve and phase accumulator by one tick
+ *  @return true if the wall should move this tick
+ */
+bool difficulty_tick(void);
+
+
+#endif
@@ -0,0 +1,204 @@
+/** @file   display.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  LED matrix display buffer
+ *          Columns are scanned by the Timer1 compare B interrupt from port values
+ *          display_update() recomputes for changed columns only, so refresh does
+ *          not depend on how long the scheduler's tasks take
+ */
+
+#include "system.h"
+#include "display.h"
+#include "ledmat.h"
+#include "timer.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+// Column scan timing, Timer1 is free running (timer.c) and compare B is moved on every scan
+#define DISPLAY_SCAN_PERIOD    (TIMER_RATE / (DISPLAY_WIDTH * DISPLAY_REFRESH_RATE))
+
+// LED matrix wiring, must match LEDMAT_ROWn_PIO/LEDMAT_COLn_PIO in system.h
+// Rows and columns are active low, all of port B and bits 4-7 of port C drive the matrix
+#define LEDMAT_PORTC_MASK      (BIT(4) | BIT(5) | BIT(6) | BIT(7))
+#define LEDMAT_COLS_PORTB      (BIT(6) | BIT(3) | BIT(2) | BIT(1) | BIT(0))
+#define LEDMAT_ROWS_PORTB      (BIT(7) | BIT(5) | BIT(4))
+
+static const uint8_t ROW_PORTB[DISPLAY_HEIGHT] = { 0, BIT(7), 0, 0, 0, BIT(4), BIT(5) };
+static const uint8_t ROW_PORTC[DISPLAY_HEIGHT] = { BIT(6), 0, BIT(4), BIT(7), BIT(5), 0, 0 };
+static const uint8_t COL_PORTB[DISPLAY_WIDTH]  = { BIT(6), BIT(3), BIT(2), BIT(1), BIT(0) };
+
+
+// Port values that light one column
+typedef struct
+{
+	uint8_t portb;
+	uint8_t portc;                        // LEDMAT_PORTC_MASK bits only
+} ColumnPortsStruct;
+
+// Front and back buffers, one byte per column, bit n is row n
+static uint8_t display_buffers[2][DISPLAY_WIDTH];
+static uint8_t front = 0;                             // Buffer being displayed, one byte so swaps are atomic
+
+// Scanned by the interrupt, bit n of dirty_columns is set while column n's ports are out of date
+static ColumnPortsStruct column_ports[DISPLAY_WIDTH];
+static uint8_t           dirty_columns = 0;
+
+
+/*  Light next column, columns are switched off while rows change so nothing ghosts
+ */
+ISR(TIMER1_COMPB_vect)
+{
+	static uint8_t col = 0;
+
+	OCR1B += DISPLAY_SCAN_PERIOD;
+
+	PORTB = LEDMAT_COLS_PORTB | LEDMAT_ROWS_PORTB;
+	PORTC = (PORTC & ~LEDMAT_PORTC_MASK) | column_ports[col].portc;
+	PORTB = column_ports[col].portb;
+
+	col++;
+	if (col >= DISPLAY_WIDTH)
+	{
+		col = 0;
+	}
+}
+
+
+/*  Initialise LED matrix, clear display buffer and start column scanning
+ *  @brief: scanning starts once timer_init() starts Timer1
+ */
+void display_init(void)
+{
+	ledmat_init();
+	display_clear();
+	display_update();
+
+	OCR1B   = TCNT1 + DISPLAY_SCAN_PERIOD;
+	TIMSK1 |= BIT(OCIE1B);
+	sei();
+}
+
+
+/*  Hold/restart the column scan
+ *  @brief: for drivers sharing the LED matrix pins (the navswitch reads
+ *          through row pins), a column due while held is lit on restart
+ *          because the compare flag stays set while its interrupt is masked
+ */
+void display_scan_hold(void)
+{
+	TIMSK1 &= ~BIT(OCIE1B);
+}
+
+
+void display_scan_release(void)
+{
+	TIMSK1 |= BIT(OCIE1B);
+}
+
+
+/*  Recompute port values of columns changed since the last call
+ *  @brief: cheap when nothing changed, call after writing to the buffer
+ *          (tinygl_update() calls it on every update)
+ */
+void display_update(void)
+{
+	uint8_t col, row;
+
+	for (col = 0; col < DISPLAY_WIDTH; col++)
+	{
+		ColumnPortsStruct ports;
+		uint8_t           pattern = display_buffers[front][col];
+
+		if (!(dirty_columns & BIT(col)))
+		{
+			continue;
+		}
+
+		// Every column off except this one, lit rows low
+		ports.portb = LEDMAT_ROWS_PORTB | (LEDMAT_COLS_PORTB & ~COL_PORTB[col]);
+		ports.portc = LEDMAT_PORTC_MASK;
+
+		for (row = 0; row < DISPLAY_HEIGHT; row++, pattern >>= 1)
+		{
+			if (pattern & 1)
+			{
+				ports.portb &= ~ROW_PORTB[row];
+				ports.portc &= ~ROW_PORTC[row];
+			}
+		}
+
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			column_ports[col] = ports;
+		}
+	}
+
+	dirty_columns = 0;
+}
+
+
+/*  Set/Get state of a single pixel
+ *  @param col: column, row: row, val: pixel state
+ */
+void display_pixel_set(uint8_t col, uint8_t row, bool val)
+{
+	if ((col >= DISPLAY_WIDTH) || (row >= DISPLAY_HEIGHT))
+	{
+		return;
+	}
+
+	if (val)
+	{
+		display_buffers[front][col] |= BIT(row);
+	}
+	else
+	{
+		display_buffers[front][col] &= ~BIT(row);
+	}
+
+	dirty_columns |= BIT(col);
+}
+
+
+bool display_pixel_get(uint8_t col, uint8_t row)
+{
+	if ((col >= DISPLAY_WIDTH) || (row >= DISPLAY_HEIGHT))
+	{
+		return false;
+	}
+
+	return (display_buffers[front][col] & BIT(row)) != 0;
+}
+
+
+/*  Turn all pixels off
+ */
+void display_clear(void)
+{
+	uint8_t col;
+
+	for (col = 0; col < DISPLAY_WIDTH; col++)
+	{
+		display_buffers[front][col] = 0;
+	}
+
+	dirty_columns = BIT(DISPLAY_WIDTH) - 1;
+}
+
+
+/*  Returns the buffer not being displayed, for a whole frame to be written into
+ */
+uint8_t *display_back_get(void)
+{
+	return display_buffers[!front];
+}
+
+
+/*  Show the back buffer, the buffer that was displayed becomes the back buffer
+ */
+void display_swap(void)
+{
+	front         = !front;
+	dirty_columns = BIT(DISPLAY_WIDTH) - 1;
+}
@@ -0,0 +1,63 @@
+/** @file   display.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  LED matrix display buffer
+ *          Replaces drivers/display.c (same API, used by tinygl) and adds
+ *          a back buffer so a whole frame can replace the displayed one at once.
+ *          The LED matrix is scanned by a timer interrupt, not display_update()
+ */
+
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include "system.h"
+
+#define DISPLAY_WIDTH           LEDMAT_COLS_NUM
+#define DISPLAY_HEIGHT          LEDMAT_ROWS_NUM
+#define DISPLAY_REFRESH_RATE    100    // Whole display scans per second
+
+
+/*  Initialise LED matrix, clear display buffer and start column scanning
+ *  @brief: scanning starts once timer_init() starts Timer1
+ */
+void display_init(void);
+
+
+/*  Hold/restart the column scan
+ *  @brief: for drivers sharing the LED matrix pins (the navswitch reads
+ *          through row pins), a column due while held is lit on restart
+ */
+void display_scan_hold(void);
+void display_scan_release(void);
+
+
+/*  Recompute port values of columns changed since the last call
+ *  @brief: cheap when nothing changed, call after writing to the buffer
+ *          (tinygl_update() calls it on every update)
+ */
+void display_update(void);
+
+
+/*  Set/Get state of a single pixel
+ *  @param col: column, row: row, val: pixel state
+ */
+void display_pixel_set(uint8_t col, uint8_t row, bool val);
+bool display_pixel_get(uint8_t col, uint8_t row);
+
+
+/*  Turn all pixels off
+ */
+void display_clear(void);
+
+
+/*  Returns the buffer not being displayed, for a whole frame to be written into
+ */
+uint8_t *display_back_get(void);
+
+
+/*  Show the back buffer, the buffer that was displayed becomes the back buffer
+ */
+void display_swap(void);
+
+
+#endif
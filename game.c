@@ -5,119 +5,133 @@
  */
 
 #include "system.h"
-#include "tinygl.h"
+#include "hal.h"
 #include "task.h"
+#include "input.h"
 #include "character.h"
 #include "wall.h"
 #include "game_manager.h"
+#include "render.h"
 #include "sound.h"
+#include "difficulty.h"
+#include "scroll.h"
+#include "replay.h"
+#include "storage.h"
+#include "task_stats.h"
 
 //Frequency of task execution in Hz
 #define DISPLAY_UPDATE_RATE            300
-#define INPUT_UPDATE_RATE              20
-#define TWEETER_TASK_RATE              TWEETER_SWITCH_RATE
-#define MELODY_TASK_RATE               100
-#define MESSAGE_RATE                   20  // Tinygl text scroll speed
+#define INPUT_UPDATE_RATE              100 // Game ticks reading input, sampled at INPUT_SAMPLE_RATE
+#define MELODY_TASK_RATE               SOUND_UPDATE_RATE
+#define WALL_TASK_RATE                 DIFFICULTY_TICK_RATE
+#define MESSAGE_RATE                   20  // Text scroll speed (characters per 10 s)
 
-//Difficulty constants
-#define WALL_SPEED_INCREMENT_RATE      20  // Delay before speed increment in seconds
-#define WALL_SPEED_INCREMENT_AMOUNT    1   // Amount wall speed increases by (walls/second)
-#define DEFAULT_SPEED                  1   // Default starting wall speed
+// Task table entries
+typedef enum
+{
+	INPUT_TASK,
+	MELODY_TASK,
+	DISPLAY_TASK,
+	CONTROL_TASK,
+	WALL_TASK,
+	GAME_TASKS                          // Number of tasks
+} GAME_TASK_t;
+
+_Static_assert(GAME_TASKS <= TASK_STATS_MAX, "task_stats.h doesn't track every task");
 
-#define WALL_TASK_INDEX                4   //Index of the wall task object within tasks array
+// Tasks enabled outside gameplay (menus, paused, GAME OVER) and during gameplay
+#define MENU_TASKS                     (BIT(INPUT_TASK) | BIT(MELODY_TASK) | BIT(DISPLAY_TASK) | BIT(CONTROL_TASK))
+#define PLAY_TASKS                     (MENU_TASKS | BIT(WALL_TASK))
 
-static uint8_t wall_speed = DEFAULT_SPEED; // Default wall speed (walls/second)
+
+/*  Enables the tasks needed in the current game state
+ *  @brief: called after anything that can change game or pause state,
+ *          so wall_task only wakes the CPU while the game is being played
+ */
+static void tasks_select(void)
+{
+	hal_tasks_enable((get_game_state() & !get_pause_state()) ? PLAY_TASKS : MENU_TASKS);
+}
 
 
 /* Update LED Matrix display
+ *  @brief: during a game, a frame is composed first if the board changed,
+ *          in the menus the pre-rendered messages are scrolled
  *  @param unused void pointer passed by task scheduler */
 static void display_task(__unused__ void *data)
 {
-	tinygl_update();         //Update display and/or scrolling text
+	render_update();         //Compose new frame (if any)
+	scroll_update();         //Scroll menu text (if any)
+	hal_display_update();    //Update display and/or debug text
 }
 
 
-/*  Wall update task moves existing wall or
- *  creates new wall and increments score
+/*  Wall update task moves existing walls and
+ *  creates new walls, incrementing score for each
+ *  @brief: runs at a fixed rate, the speed curve (difficulty.h) decides which ticks are wall steps.
+ *          Only enabled during gameplay (tasks_select())
  *  @param unused void pointer passed by task scheduler */
 static void wall_task(__unused__ void *data)
 {
-	if (get_game_state() & !get_pause_state())
+	if (!difficulty_tick())
+	{
+		return;
+	}
+
+	if (move_walls())
 	{
-		if (get_active_wall().wall_type == OUT_OF_BOUNDS)
-		{
-			wall_create();
-			increment_score();
-		}
-		else
-		{
-			move_wall();
-			toggle_stun(0);                         // Reset stun condition when wall moves over character
-		}
+		toggle_stun(0);                         // Reset stun condition when wall moves over character
+	}
+
+	if (wall_spawn_due())
+	{
+		wall_create(wall_count() ? WALL_CROSSING_PERIOD : WALL_FULL_SPEED);
+		increment_score();
+	}
 
+	if (wall_impact_p())
+	{
 		check_collisions();
 	}
+
+	tasks_select();                             // Game may have ended
 }
 
 
-/*  Character movement input polling
+/*  Sample navswitch and button into the input queues
  *  @param unused void pointer passed by task scheduler */
-static void character_task(__unused__ void *data)
+static void input_task(__unused__ void *data)
 {
-	if (get_game_state() & !get_pause_state())
-	{
-		character_update();
-	}
+	input_sample();
 }
 
 
-/*  Start/Resume game and reset difficulty on restart
- *  @param task_t pointer of task to reset period*/
-static void start_game_task(void *data)
+/*  Game input tick: publishes this tick's input snapshot (recorded, or
+ *  replaced by a replay's or the demo's), then moves the character, runs the
+ *  menus or pauses/resumes from it. Writes at most one queued EEPROM byte
+ *  @param unused void pointer passed by task scheduler */
+static void control_task(__unused__ void *data)
 {
-	task_t *task = data;
+	input_update();
+	replay_update();
+	game_demo_update();                          // Demo game's move, a press ends the demo
+
+	if (get_game_state() & !get_pause_state())
+	{
+		character_update();
+	}
 
 	if (!get_game_state())
 	{
-		// Reset difficulty
-		wall_speed   = DEFAULT_SPEED;
-		task->period = TASK_RATE / wall_speed;
 		game_state_update();
 	}
-
-	check_pause_button();
-}
-
-
-/*  Wall update task moves existing wall or
- *  creates new wall and increments score
- *  @param task_t pointer of task to increase rate*/
-static void difficulty_task(void *data)
-{
-	if (!get_pause_state())
+	else
 	{
-		static uint8_t counter = 0;                 // Tracks number of function calls
-		task_t         *task   = data;
-
-		task->period = TASK_RATE / wall_speed;
-		counter++;
-
-		// Increases speed after WALL_SPEED_INCREMENT_RATE times the task frequency
-		if (counter >= WALL_SPEED_INCREMENT_RATE)
-		{
-			wall_speed  += WALL_SPEED_INCREMENT_AMOUNT;
-			task->period = TASK_RATE / wall_speed;
-			counter      = 0;
-		}
+		check_pause_button();                    // Not on the tick the game starts, the start press isn't a pause
 	}
-}
-
 
-/*  Tweeter update task to make speaker sound
- *  @param unused void pointer passed by task scheduler */
-static void tweeter_task(__unused__ void *data)
-{
-	speaker_update();
+	storage_update();                            // High score and replay, one byte per tick
+	tasks_select();
 }
 
 
@@ -132,25 +146,24 @@ static void melody_task(__unused__ void *data)
 int main(void)
 {
 	// Module initialization
-	system_init();
-	tinygl_init(DISPLAY_UPDATE_RATE);
+	hal_init(DISPLAY_UPDATE_RATE);
+	scroll_init(MESSAGE_RATE, DISPLAY_UPDATE_RATE);
 	game_init(MESSAGE_RATE);
-	sound_init(MELODY_TASK_RATE);
+	sound_init();
 
 	// Task definitions
 	task_t tasks[] =
 	{
-		{ .func = tweeter_task,    .period = TASK_RATE / TWEETER_TASK_RATE   },
-		{ .func = melody_task,     .period = TASK_RATE / MELODY_TASK_RATE    },
-		{ .func = display_task,    .period = TASK_RATE / DISPLAY_UPDATE_RATE },
-		{ .func = character_task,  .period = TASK_RATE / INPUT_UPDATE_RATE   },
-		{ .func = wall_task,       .period = TASK_RATE / wall_speed          },
-		{ .func = difficulty_task, .period = TASK_RATE, .data = &(tasks[WALL_TASK_INDEX])},
-		{ .func = start_game_task, .period = TASK_RATE / INPUT_UPDATE_RATE, .data = &(tasks[WALL_TASK_INDEX])},
+		[INPUT_TASK]   = { .func = input_task,      .period = TASK_RATE / INPUT_SAMPLE_RATE   },
+		[MELODY_TASK]  = { .func = melody_task,     .period = TASK_RATE / MELODY_TASK_RATE    },
+		[DISPLAY_TASK] = { .func = display_task,    .period = TASK_RATE / DISPLAY_UPDATE_RATE },
+		[CONTROL_TASK] = { .func = control_task,    .period = TASK_RATE / INPUT_UPDATE_RATE   },
+		[WALL_TASK]    = { .func = wall_task,       .period = TASK_RATE / WALL_TASK_RATE      },
 	};
 
-	// Run tasks
-	task_schedule(tasks, ARRAY_SIZE(tasks));
+	// Run tasks, sleeping in between
+	hal_tasks_enable(MENU_TASKS);
+	hal_run(tasks, ARRAY_SIZE(tasks));
 
 	return 0;
 }
@@ -11,57 +11,91 @@
 #include "game_manager.h"
 #include "character.h"
 #include "wall.h"
+#include "board.h"
+#include "render.h"
 #include "sound.h"
-#include "button.h"
-#include "navswitch.h"
-#include "tinygl.h"
-#include "../fonts/font3x5_1.h"
-#include "uint8toa.h"
-#include "led.h"
+#include "game_state.h"
+#include "scroll.h"
+#include "replay.h"
+#include "highscore.h"
+#include "autoplay.h"
+#include "hal.h"
+#include "input.h"
+#include "difficulty.h"
+#include "task_stats.h"
+#include <avr/pgmspace.h>
+
+
+// Note streams generated from sounds/*.mmel at build time (see sound.h)
+static const uint8_t GAME_MUSIC[] PROGMEM =     // Music to loop during gameplay
+{
+#include "sounds/megalovania.notes"
+};
 
+static const uint8_t END_GAME_MUSIC[] PROGMEM = // End menu music, loops
+{
+#include "sounds/rick_roll.notes"
+};
+
+static const uint8_t MENU_TONE[] PROGMEM =      // Menu navigation tone, plays once
+{
+#include "sounds/menu_tone.notes"
+};
 
-static char GAME_MUSIC[] =   // Music to loop during gameplay
+static const uint8_t HIT_EFFECT[] PROGMEM =     // Sound effect of a collision, over the music
 {
-#include "sounds/megalovania.mmel"
-	     " :"                   // Loop indefinitely
+#include "sounds/hit.notes"
 };
 
-static char END_GAME_MUSIC[] = // End menu music
+static const uint8_t SCORE_EFFECT[] PROGMEM =   // Sound effect of a new wall (point scored)
 {
-#include "sounds/rick_roll.mmel"
-	     " :"         // Loop indefinitely
+#include "sounds/score.notes"
 };
 
 // Game Constants
-static GAMESTATES_t active_game      = MENU_STATE;
-static uint8_t      score            = 0;
-static uint8_t      game_mode_index  = 0;
-static bool         pause_status     = false;
-uint8_t             wall_random_seed = 0;
+// Score, game state, gamemode and pause are part of the game state (see game_state.h)
+uint16_t        wall_random_seed = 0;
+static uint16_t menu_idle_ticks  = 0;             // Game ticks in the title menu without a press
+static uint8_t  demo_mode        = 0;             // GAMEMODES_t of the next demo game
+static uint8_t  player_mode      = HARD_MODE;     // Gamemode selected by the player, kept over a demo or replay
+static bool     outro_enabled    = true;          // A lost game goes on to game_outro()
+#ifdef TASK_STATS_DEBUG
+static uint8_t  stats_task;                       // Task shown on the GAME OVER debug screen
+#endif
+
+
+static const MESSAGE_t GAMEMODE_MESSAGES[] = // Gamemode prompts (pre-rendered, see scroll.h)
+{
+	[HARD_MODE]   = MESSAGE_HARD_MODE,
+	[THREE_LIVES] = MESSAGE_THREE_LIVES,
+	[WALL_PUSH]   = MESSAGE_WALL_PUSH
+};
 
+static const DIFFICULTY_CURVE_t GAMEMODE_CURVES[] = // Wall speed curve of each gamemode
+{
+	[HARD_MODE]   = CURVE_EXPONENTIAL,
+	[THREE_LIVES] = CURVE_LINEAR,
+	[WALL_PUSH]   = CURVE_STEPPED
+};
 
-char *GAMEMODE_STRINGS[] = // Gamemode prompts
+static const uint8_t GAMEMODE_WALLS[] = // Walls on the display at once in each gamemode
 {
-	HARD_MODE_TEXT,
-	THREE_LIVES_TEXT,
-	WALL_PUSH_TEXT
+	[HARD_MODE]   = 1,
+	[THREE_LIVES] = 2,                  // Second wall crosses the first at half speed
+	[WALL_PUSH]   = 1
 };
 
 
 /*  Initialize game manager, LED and starts game menu
  *  @param message_rate: text scroll speed of MENU texts
- *  @brief: using 3x5 font, displays " SELECT GAME MODE "
+ *  @brief: loads best scores, scrolls " SELECT GAME MODE ", tinygl text is only
+ *          used for the scheduler statistics of debug builds (see task_stats_show())
  */
 void game_init(uint8_t message_rate)
 {
-	button_init();
-	led_init();
-	led_set(LED1, 0);
-	tinygl_text_speed_set(message_rate);
-	tinygl_font_set(&font3x5_1);
-	tinygl_text_mode_set(TINYGL_TEXT_MODE_SCROLL);
-	tinygl_text_dir_set(TINYGL_TEXT_DIR_ROTATE);
-	tinygl_text(GAME_MODE_PROMPT);
+	hal_text_init(message_rate);
+	highscore_init();                      // Best scores from EEPROM
+	scroll_message(MESSAGE_GAME_MODE_PROMPT);
 }
 
 
@@ -72,7 +106,7 @@ void game_init(uint8_t message_rate)
 bool get_game_state()
 {
 	wall_random_seed++;         // Increments variable wall_random_seed
-	return(active_game == GAME_PLAY_STATE);
+	return(game_state_get()->active_game == GAME_PLAY_STATE);
 }
 
 
@@ -81,7 +115,7 @@ bool get_game_state()
  */
 bool get_pause_state()
 {
-	return pause_status;
+	return game_state_get()->pause_status;
 }
 
 
@@ -91,12 +125,13 @@ bool get_pause_state()
  */
 void check_pause_button()
 {
-	button_update();                                                        // Update button input
-	if (button_push_event_p(0) && (active_game == GAME_PLAY_STATE))         // if button is pressed AND game is active
+	const GameStateStruct *game = game_state_get();
+
+	if (input_pressed_p(INPUT_BUTTON) && (game->active_game == GAME_PLAY_STATE))  // if button is pressed AND game is active
 	{
-		pause_status = !pause_status;                                       // Toggles pause state each press
-		led_set(LED1, pause_status);                                        // If paused, LED lights up
-		if (pause_status)
+		game_state_pause_set(!game->pause_status);                          // Toggles pause state each press
+		hal_led_set(game->pause_status);                                    // If paused, LED lights up
+		if (game->pause_status)
 		{
 			sound_play(MENU_TONE);                          // If paused, MENU_TONE is played
 		}
@@ -108,53 +143,158 @@ void check_pause_button()
 }
 
 
+/*  Back to the title menu
+ */
+static void menu_enter(void)
+{
+	hal_display_clear();                   // Stops debug text (see task_stats_show())
+	scroll_message(MESSAGE_GAME_MODE_PROMPT);
+	sound_play(MENU_TONE);
+	menu_idle_ticks   = 0;
+	game_state_active_game_set(MENU_STATE);
+}
+
+
+/*  Start a demo game, played by autoplay.c, each demo shows the next gamemode
+ *  @brief: demo games aren't recorded or scored, the player's gamemode
+ *          is put back when the demo ends
+ */
+static void demo_start(void)
+{
+	player_mode = game_state_get()->mode;
+	game_mode_set((GAMEMODES_t)demo_mode);
+	demo_mode = (demo_mode + 1) % DIFFERENT_GAMEMODES;
+	autoplay_start(AUTOPLAY_DEMO_PERIOD);
+	game_start();
+}
+
+
+/*  End the demo game, back to the title menu on the player's gamemode
+ */
+static void demo_stop(void)
+{
+	autoplay_stop();
+	render_stop();
+	game_mode_set((GAMEMODES_t)player_mode);
+	menu_enter();
+}
+
+
+/*  Plays the demo game, any press ends it
+ *  @brief: the press that ends the demo is dropped
+ */
+void game_demo_update(void)
+{
+	if (!autoplay_active_p())
+	{
+		return;
+	}
+
+	if (input_snapshot()->presses)
+	{
+		demo_stop();
+		input_presses_set(0);
+		return;
+	}
+
+	autoplay_update();
+}
+
+
+#ifdef TASK_STATS_DEBUG
+/*  Scrolls worst run time and missed deadlines of the next task that ran
+ *  @brief: debug builds (make DEBUG=1) step through the tasks with
+ *          navswitch east at GAME OVER, one task per message so it fits
+ *          tinygl's buffer. The text is built at runtime so tinygl scrolls it
+ */
+static void task_stats_show(void)
+{
+	static char message[TASK_STATS_TEXT_SIZE];
+	uint8_t     tries;
+
+	for (tries = 0; tries < TASK_STATS_MAX; tries++)
+	{
+		stats_task = (stats_task + 1) % TASK_STATS_MAX;
+
+		if (task_stats_text(stats_task, message))
+		{
+			scroll_stop();                 // Display is handed to tinygl
+			hal_text(message);
+			return;
+		}
+	}
+}
+#endif
+
+
 /*  Updates game states
- *  @brief: checks navswitch to scroll through menu (if in menu).
- *          checks for button push to either redo game or select gamemode.
+ *  @brief: navswitch push scrolls through menu (if in menu).
+ *          button push either redoes game or selects gamemode.
  */
 void game_state_update()
 {
-	navswitch_update();
-	button_update();
+	const GameStateStruct *game = game_state_get();
 
-	switch (active_game)
+	switch (game->active_game)
 	{
 	case MENU_STATE:
+		// Demo game once the title has been left alone for DEMO_IDLE_TICKS
+		if (input_snapshot()->presses == 0)
+		{
+			if (++menu_idle_ticks >= DEMO_IDLE_TICKS)
+			{
+				demo_start();
+			}
+			break;
+		}
+
+		menu_idle_ticks = 0;
+
+		// Navswitch north plays the last game again (see replay.h)
+		if (input_pressed_p(INPUT_NORTH) && replay_play())
+		{
+			player_mode = game->mode;      // Put back by game_outro()
+			game_state_mode_set(replay_mode());
+			wall_random_seed = replay_seed();
+			game_start();
+			break;
+		}
+
 		// If any input, gamemode is displayed and game state if SELECTION
-		if (navswitch_push_event_p(NAVSWITCH_PUSH) | button_push_event_p(0))
+		if (input_pressed_p(INPUT_PUSH) | input_pressed_p(INPUT_BUTTON))
 		{
 			sound_play(MENU_TONE);
-			active_game = SELECTION_STATE;
-			tinygl_clear();
-			tinygl_text(GAMEMODE_STRINGS[game_mode_index]);
+			game_state_active_game_set(SELECTION_STATE);
+			scroll_message(GAMEMODE_MESSAGES[game->mode]);
 		}
 		break;
 
 	case SELECTION_STATE:
 
-		if (navswitch_push_event_p(NAVSWITCH_PUSH))                         // Change game mode
+		if (input_pressed_p(INPUT_PUSH))                                    // Change game mode
 		{
-			tinygl_clear();
-			game_mode_index = (game_mode_index + 1) % DIFFERENT_GAMEMODES;                               // Update GAMEMODE_index (currently selected)
-			tinygl_text(GAMEMODE_STRINGS[game_mode_index]);                                              // Display different gamemode text
+			game_state_mode_set((game->mode + 1) % DIFFERENT_GAMEMODES);                                 // Update GAMEMODE_index (currently selected)
+			scroll_message(GAMEMODE_MESSAGES[game->mode]);                                               // Display different gamemode text
 			sound_play(MENU_TONE);
 		}
 
-		if (button_push_event_p(0))                         // Start game
+		if (input_pressed_p(INPUT_BUTTON))                     // Start game
 		{
-			active_game = GAME_PLAY_STATE;
 			game_start();
 		}
 		break;
 
 	case GAME_END_STATE:             // Return to menu
-		if (navswitch_push_event_p(NAVSWITCH_PUSH) | button_push_event_p(0))
+		if (input_pressed_p(INPUT_PUSH) | input_pressed_p(INPUT_BUTTON))
 		{
-			tinygl_clear();
-			tinygl_text(GAME_MODE_PROMPT);
-			sound_play(MENU_TONE);
-			active_game = MENU_STATE;
+			menu_enter();
 		}
+#ifdef TASK_STATS_DEBUG
+		else if (input_pressed_p(INPUT_EAST))
+		{
+			task_stats_show();
+		}
+#endif
 
 		break;
 
@@ -165,15 +305,25 @@ void game_state_update()
 }
 
 
+/*  Select gamemode used by the next game_start()
+ *  @param mode: gamemode to play
+ */
+void game_mode_set(GAMEMODES_t mode)
+{
+	game_state_mode_set(mode);
+}
+
+
 /*  Initialize game components when starting
  *  @brief: gives player lives depending on game mode
  *          initialises all modules used in game
  */
 void game_start()
 {
-	uint8_t player_lives;
+	const GameStateStruct *game = game_state_get();
+	uint8_t               player_lives;
 
-	switch ((GAMEMODES_t)game_mode_index)          // Set player lives based on game mode
+	switch ((GAMEMODES_t)game->mode)               // Set player lives based on game mode
 	{
 	case THREE_LIVES:
 		player_lives = 3;                     // Can collide with wall up to 3 times
@@ -191,50 +341,81 @@ void game_start()
 		player_lives = 3;                 // Game will default to three_lives mode (if index > 3)
 	}
 
-	tinygl_clear();                        // Clear display
+	scroll_stop();                         // Display is handed to the board
+	hal_display_clear();                   // Clear display
+	input_flush();                         // Drop presses made in the menus
 	character_init(player_lives);          // Initialise character module (with given lives)
+
+	if (!replay_playing_p() && !autoplay_active_p())
+	{
+		replay_record(wall_random_seed, game->mode);   // Presses are recorded from the next tick
+	}
+
 	wall_init(wall_random_seed);           // Initialises wall module with random seed
+	wall_weights_set(game->mode);          // Walls are weighted per gamemode
+	wall_limit_set((game->mode < DIFFERENT_GAMEMODES) ? GAMEMODE_WALLS[game->mode] : 1);
+	difficulty_start((game->mode < DIFFERENT_GAMEMODES) ? GAMEMODE_CURVES[game->mode] : CURVE_LINEAR);
+	render_start();                        // Board is drawn from now on
 
 	sound_play(GAME_MUSIC);                // Plays game music
-	score       = 0;                       // Reset gamescore (from previous game)
-	active_game = GAME_PLAY_STATE;         // game is started so playing state
+	task_stats_reset();                    // Scheduler statistics cover one game
+	game_state_score_set(0);                        // Reset gamescore (from previous game)
+	game_state_active_game_set(GAME_PLAY_STATE);    // game is started so playing state
 }
 
 
-/*  Outlines process of a game_ending (text display, music played)
- *  @brief: Displays score and plays ending music END_GAME_MUSIC
+/*  End the game being played, walls and player stop and are no longer drawn
+ *  @brief: nothing is scored, stored, shown or played, game_outro() does that
  */
-void game_outro()
+void game_stop()
 {
-	char end_message[END_PROMPT_LEN + SIZE_OF_UINT8] = END_PROMPT;
+	game_state_active_game_set(GAME_END_STATE);
+	render_stop();                         // Display is handed to the GAME OVER text
+}
 
-	uint8toa(score, end_message + END_PROMPT_LEN, false);
-	tinygl_text(end_message);
-	sound_play(END_GAME_MUSIC);
+
+/*  Select whether a lost game goes on to game_outro() (the default)
+ *  @param enabled: false ends lost games with game_stop() alone
+ */
+void game_outro_enable(bool enabled)
+{
+	outro_enabled = enabled;
 }
 
 
-/*  Checks whether wall has collided with player
- *  @brief: For a collsion to occur, player and ACTIVE_WALL must have
- *          same position AND player must overlap with wall.
- *          Used in function check_collisions()
+/*  Outlines process of a game_ending (text display, high score, replay, music played)
+ *  @brief: Displays score and best score, stores them and the replay
+ *          and plays ending music END_GAME_MUSIC, a demo game goes
+ *          straight back to the title menu and a replay puts the
+ *          player's gamemode back
  */
-static bool collision_dectection(void)
+void game_outro()
 {
-	CharacterInfoStruct character_info = get_character_info();
-	WallStruct          wall           = get_active_wall();
+	const GameStateStruct *game = game_state_get();
 
-	// Checks whether player overlaps the wall, by creating bitmap of character (e.g. 00000100)
-	// If (character bitmap) & (wall bitmap) is not zero, then player overlaps with wall_bitmap
-	uint8_t player_bitmap       = (wall.wall_type == ROW) ? BIT(character_info.x): BIT(character_info.y);
-	bool    potential_collision = (wall.bit_data & player_bitmap) != 0;
+	if (autoplay_active_p())
+	{
+		demo_stop();                       // Demo isn't scored
+		return;
+	}
 
-	// Checks whether the player is inline with the ACTIVE_WALL position
-	// If ROW wall_type, then wall position is compared to the characters y coord, else x coord
-	uint8_t player_index     = (wall.wall_type == ROW) ? character_info.y: character_info.x;
-	bool    is_same_position = player_index == wall.pos;
+	if (!replay_playing_p())
+	{
+		highscore_submit(game->mode, game->score);   // Replays don't count
+	}
 
-	return(potential_collision & is_same_position);
+	scroll_score(game->score, highscore_best(game->mode));
+#ifdef TASK_STATS_DEBUG
+	stats_task = TASK_STATS_MAX - 1;       // Navswitch east shows task 0 first
+#endif
+
+	if (replay_playing_p())
+	{
+		game_mode_set((GAMEMODES_t)player_mode);   // Replay is over, the player's gamemode is back
+	}
+
+	replay_stop();                         // Recording is queued to be stored in EEPROM
+	sound_play(END_GAME_MUSIC);
 }
 
 
@@ -245,9 +426,14 @@ static bool collision_dectection(void)
  */
 static void gamemode_collsion_process(void)
 {
-	bool player_at_border;         // boolean describing if player is pushed beyond border
+	bool                      player_at_border;   // boolean describing if player is pushed beyond border
+	const WallStruct          *wall;              // Wall the player collided with
+	const CharacterInfoStruct *character = get_character_info();
+	const GameStateStruct     *game      = game_state_get();
+
+	sound_effect_play(HIT_EFFECT, SOUND_PRIORITY_HIT);
 
-	switch ((GAMEMODES_t)game_mode_index)
+	switch ((GAMEMODES_t)game->mode)
 	{
 	case HARD_MODE:
 	case THREE_LIVES:
@@ -258,21 +444,24 @@ static void gamemode_collsion_process(void)
 		break;
 
 	case WALL_PUSH:
-		// Will move character in direction of wall movement)
-		if (get_active_wall().wall_type == ROW)
+		// Will move character in direction of movement of the wall it collided with
+		wall = wall_at(character->x, character->y);
+
+		if (wall == NULL)
+		{
+			break;
+		}
+
+		if (wall->wall_type == ROW)
 		{
 			// Since Wall is ROW, wall is moving either NORTH or SOUTH
-			player_at_border = (get_active_wall().direction == NORTH) ? move_north(): move_south();
+			player_at_border = (wall->direction == NORTH) ? move_north(): move_south();
 		}
 		else                 // Since Wall is COLUMN, wall is moving either EAST or WEST
 		{
-			player_at_border = (get_active_wall().direction == EAST) ? move_east(): move_west();
+			player_at_border = (wall->direction == EAST) ? move_east(): move_west();
 		}
 
-		/* Re-display the part of wall which collided with player  */
-		/*   (which disappears after player is moved)              */
-		toggle_wall(1);
-
 		if (player_at_border)
 		{
 			// Kills player if pushed beyond the wall
@@ -290,39 +479,48 @@ static void gamemode_collsion_process(void)
  *  @brief: As mentioned, stun was introduced so player doesn't have multiple loss of lives from single collision
  *		Function only returns true if collsion & not stunned player cannot move whilst stunned
  *		(stun is removed after wall moves away, prevent player moving into another part of wall)
+ *		Only called on steps where a wall reached the player (wall_impact_p())
  */
 void check_collisions()
 {
-	if (get_game_state())
+	if (!get_stun_condition())                      // Wall reached the player and not stunned
 	{
-		if (collision_dectection() & !get_stun_condition())                 // If collision and not stunned
-		{
-			gamemode_collsion_process();                                    // What occurs during a collision
-		}
+		gamemode_collsion_process();                // What occurs during a collision
 	}
 }
 
 
 /*  Decreases player lives
  *  @brief: decrease_character_lives() decreases lives and return true is lives = 0
- *          if lives = 0, game enters ending state
+ *          if lives = 0, game enters ending state (see game_outro_enable())
  */
 void decrease_lives()
 {
 	if (decrease_character_lives())
 	{
-		active_game = GAME_END_STATE;
-		toggle_wall(false);
-		character_disable();
-		game_outro();
+		game_stop();
+
+		if (outro_enabled)
+		{
+			game_outro();
+		}
 	}
 }
 
 
 /*  Increments game score
- *  @brief: as there is a single moving wall, this is called ervery time the wall resets
+ *  @brief: called every time a new wall is created
  */
 void increment_score()
 {
-	score++;
+	game_state_score_set(game_state_get()->score + 1);
+	sound_effect_play(SCORE_EFFECT, SOUND_PRIORITY_SCORE);
+}
+
+
+/*  Returns score of current (or last) game
+ */
+uint8_t get_score()
+{
+	return game_state_get()->score;
 }
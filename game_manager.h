@@ -12,18 +12,18 @@
 
 #include "system.h"
 
-// Menu Constants
+// Menu Constants (rendered into flash by host/textgen, see scroll.h)
 #define GAME_MODE_PROMPT       " SELECT GAMEMODE "
 #define END_PROMPT             " GAME OVER SCORE:" //Additional whitespace to insert score
+#define BEST_PROMPT            "BEST:"            //Follows the score and a space
 #define END_PROMPT_LEN         17
 #define SIZE_OF_UINT8          8                   //For buffer on end message for score
-#define MENU_TONE              "A,A#,"
 // Menu text for each gamemode (for displaying)
 #define HARD_MODE_TEXT         " HARDMODE "
 #define THREE_LIVES_TEXT       " THREE LIVES "
 #define WALL_PUSH_TEXT         " WALL PUSH "
 #define DIFFERENT_GAMEMODES    3
-
+#define DEMO_IDLE_TICKS        1000  // Game ticks in the title menu without a press before a demo game (10 s)
 
 
 // Enum containing all different gamemodes
@@ -47,7 +47,8 @@ typedef enum
 
 /*  Initialize game manager, LED and starts game menu
  *  @param message_rate: text scroll speed of MENU texts
- *  @brief: using 3x5 font, displays " SELECT GAME MODE "
+ *  @brief: loads best scores, scrolls " SELECT GAME MODE ", tinygl text is only
+ *          used for the scheduler statistics of debug builds
  */
 void game_init(uint8_t message_rate);
 
@@ -73,12 +74,27 @@ void check_pause_button(void);
 
 
 /*  Updates game states
- *  @brief: checks navswitch to scroll through menu (if in menu).
+ *  @brief: checks navswitch to scroll through menu (if in menu),
+ *          navswitch north in the title menu plays the stored replay,
+ *          DEMO_IDLE_TICKS without a press in it starts a demo game.
  *          checks for button push to either redo game or select gamemode.
  */
 void game_state_update(void);
 
 
+/*  Plays the demo game (see autoplay.h), any press ends it
+ *  @brief: call once per game tick after replay_update(), the press that
+ *          ends the demo is dropped so it doesn't also act in the menu
+ */
+void game_demo_update(void);
+
+
+/*  Select gamemode used by the next game_start()
+ *  @param mode: gamemode to play
+ */
+void game_mode_set(GAMEMODES_t mode);
+
+
 /*  Initialize game components when starting
  *  @brief: gives player lives depending on game mode
  *          initialises all modules used in game
@@ -86,8 +102,22 @@ void game_state_update(void);
 void game_start(void);
 
 
-/*  Outlines process of a game_ending (text display, music played)
- *  @brief: Displays score and plays ending music END_GAME_MUSIC
+/*  End the game being played, walls and player stop and are no longer drawn
+ *  @brief: nothing is scored, stored, shown or played, game_outro() does that
+ */
+void game_stop(void);
+
+
+/*  Select whether a lost game goes on to game_outro() (the default)
+ *  @param enabled: false ends lost games with game_stop() alone, for
+ *         simulations that only read the score (host/sim.c)
+ */
+void game_outro_enable(bool enabled);
+
+
+/*  Outlines process of a game_ending (text display, high score, replay, music played)
+ *  @brief: Displays score and best score, stores them and the replay
+ *          and plays ending music END_GAME_MUSIC
  */
 void game_outro(void);
 
@@ -96,21 +126,27 @@ void game_outro(void);
  *  @brief: As mentioned, stun was introduced so player doesn't have multiple loss of lives from single collision
  *		Function only returns true if collsion & not stunned player cannot move whilst stunned
  *		(stun is removed after wall moves away, prevent player moving into another part of wall)
+ *		Only called on steps where a wall reached the player (wall_impact_p())
  */
 void check_collisions(void);
 
 
 /*  Decreases player lives
  *  @brief: decrease_character_lives() decreases lives and return true is lives = 0
- *          if lives = 0, game enters ending state
+ *          if lives = 0, game enters ending state (see game_outro_enable())
  */
 void decrease_lives(void);
 
 
 /*  Increments game score
- *  @brief: as there is a single moving wall, this is called every time the wall resets
+ *  @brief: called every time a new wall is created
  */
 void increment_score(void);
 
 
+/*  Returns score of current (or last) game
+ */
+uint8_t get_score(void);
+
+
 #endif
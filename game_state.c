@@ -0,0 +1,82 @@
+/** @file   game_state.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  State of the game being played
+ */
+
+#include "system.h"
+#include "game_state.h"
+#include "board.h"
+
+static GameStateStruct game_state;
+
+
+/*  Returns state of the current (or last) game, read only
+ */
+const GameStateStruct *game_state_get(void)
+{
+	return &game_state;
+}
+
+
+/*  Game manager fields
+ */
+void game_state_score_set(uint8_t score)
+{
+	game_state.score = score;
+}
+
+
+void game_state_active_game_set(uint8_t state)
+{
+	game_state.active_game = state;
+}
+
+
+void game_state_mode_set(uint8_t mode)
+{
+	game_state.mode = mode;
+}
+
+
+void game_state_pause_set(bool paused)
+{
+	game_state.pause_status = paused;
+}
+
+
+/*  Character fields
+ *  @brief: the player is moved on the bitboard with the character
+ */
+void game_state_player_move(uint8_t x, uint8_t y)
+{
+	game_state.character.x = x;
+	game_state.character.y = y;
+	board_player_set(x, y);
+}
+
+
+void game_state_lives_set(uint8_t lives)
+{
+	game_state.character.lives = lives;
+}
+
+
+void game_state_stun_set(bool stunned)
+{
+	game_state.character.is_stunned = stunned;
+}
+
+
+/*  Wall pool and bitboard, for their owning modules
+ */
+WallPoolStruct *game_state_walls_edit(void)
+{
+	return &game_state.walls;
+}
+
+
+BoardStruct *game_state_board_edit(void)
+{
+	return &game_state.board;
+}
@@ -0,0 +1,64 @@
+/** @file   game_state.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  State of the game being played
+ *          Everything a game changes (game manager, character, walls and the
+ *          bitboard) is in one bitfield-packed struct owned by game_state.c.
+ *          Every module reads it through game_state_get() (read only) and changes
+ *          it through the mutators below: named setters for the game manager
+ *          and character fields, and an edit pointer to the wall pool and the
+ *          bitboard for the module that owns each (wall.c and board.c).
+ *          Difficulty and rendering are kept by their modules.
+ */
+
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+#include "system.h"
+#include "character.h"
+#include "wall.h"
+#include "board.h"
+
+
+typedef struct
+{
+	uint8_t             score;
+	uint8_t             active_game  : 2;      // GAMESTATES_t
+	uint8_t             mode         : 2;      // GAMEMODES_t
+	uint8_t             pause_status : 1;
+	CharacterInfoStruct character;
+	WallPoolStruct      walls;
+	BoardStruct         board;                 // Walls and player as bitmasks (board.h)
+} GameStateStruct;
+
+
+/*  Returns state of the current (or last) game, read only
+ */
+const GameStateStruct *game_state_get(void);
+
+
+/*  Game manager fields (game_manager.c)
+ *  @param score: score, state: GAMESTATES_t, mode: GAMEMODES_t, paused: pause state
+ */
+void game_state_score_set(uint8_t score);
+void game_state_active_game_set(uint8_t state);
+void game_state_mode_set(uint8_t mode);
+void game_state_pause_set(bool paused);
+
+
+/*  Character fields (character.c)
+ *  @param x: column, y: row, lives: up to 3, stunned: stun state
+ *  @brief: moving the character also moves the player on the bitboard
+ */
+void game_state_player_move(uint8_t x, uint8_t y);
+void game_state_lives_set(uint8_t lives);
+void game_state_stun_set(bool stunned);
+
+
+/*  Wall pool and bitboard, only changed by wall.c and board.c
+ */
+WallPoolStruct *game_state_walls_edit(void);
+BoardStruct *game_state_board_edit(void);
+
+
+#endif
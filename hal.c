@@ -0,0 +1,461 @@
+/** @file   hal.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Hardware abstraction layer (UCFK4 backend)
+ */
+
+#include "system.h"
+#include "hal.h"
+#include "task.h"
+#include "task_stats.h"
+#include "timer.h"
+#include "display.h"
+#include "tinygl.h"
+#include "../fonts/font3x5_1.h"
+#include "navswitch.h"
+#include "button.h"
+#include "led.h"
+#include "pio.h"
+#include "mixer.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/eeprom.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+#include <stddef.h>
+
+// Pins for speaker to plug into
+#define SPEAKER_PIN1    PIO_DEFINE(PORT_D, 4) // Pin 1
+#define SPEAKER_PIN2    PIO_DEFINE(PORT_D, 6) // Pin 3
+#define SPEAKER_MASK    (BIT(4) | BIT(6))     // Both pins in PORTD
+
+// Tone generation (Timer0, CTC mode): one interrupt per half period while one
+// voice sounds, one per mixer sample while both do
+#define TONE_OCTAVE             6                                     // Octave of TONE_HALF_PERIODS (C5..B5)
+#define TONE_HALF_PERIOD(FREQ)  ((uint16_t)(F_CPU / (2 * (FREQ)) + 0.5))
+#define TONE_MIX_PRESCALER      8
+#define TONE_MIX_CLOCK          BIT(CS01)                             // Clock select of TONE_MIX_PRESCALER
+#define TONE_MIX_TOP            (F_CPU / TONE_MIX_PRESCALER / MIXER_SAMPLE_RATE - 1)
+
+// CPU cycles between speaker toggles for MIDI notes 72..83, other octaves are shifted
+static const uint16_t TONE_HALF_PERIODS[] PROGMEM =
+{
+	TONE_HALF_PERIOD(523.25), TONE_HALF_PERIOD(554.37), TONE_HALF_PERIOD(587.33),
+	TONE_HALF_PERIOD(622.25), TONE_HALF_PERIOD(659.26), TONE_HALF_PERIOD(698.46),
+	TONE_HALF_PERIOD(739.99), TONE_HALF_PERIOD(783.99), TONE_HALF_PERIOD(830.61),
+	TONE_HALF_PERIOD(880.00), TONE_HALF_PERIOD(932.33), TONE_HALF_PERIOD(987.77)
+};
+
+// Timer0 prescalers as shifts, index + 1 is the clock select (CS0n) value
+static const uint8_t TONE_PRESCALER_SHIFTS[] = {0, 3, 6, 8, 10};
+
+static MixerStruct   mixer;                                           // Steps are written under ATOMIC_BLOCK
+static uint8_t       tone_notes[HAL_VOICES];                          // Note of each voice, 0 if silent
+static uint8_t       tone_single;                                     // Note of the half period path, 0 if not running
+static volatile bool tone_mixing;                                     // Interrupt runs the mixer
+static bool          speaker_high;                                    // SPEAKER_PIN1 high, SPEAKER_PIN2 low
+
+// Task table entries hal_run() runs, bit n is tasks[n]
+static uint8_t tasks_enabled = 0xFF;
+
+
+/*  Initialise board (system clock, display, inputs, LED)
+ *  @param display_rate: rate hal_display_update() is called in hz
+ */
+void hal_init(uint16_t display_rate)
+{
+	system_init();
+	tinygl_init(display_rate);
+	navswitch_init();
+	button_init();
+	led_init();
+	led_set(LED1, 0);
+}
+
+
+/*  Wakes the CPU when the next task is due
+ */
+ISR(TIMER1_COMPA_vect)
+{
+}
+
+
+/*  Returns true once the scheduler clock has reached tick
+ */
+static bool timer_due_p(timer_tick_t tick)
+{
+	return (timer_tick_t)(timer_get() - tick) < (timer_tick_t) ~0 / 2;
+}
+
+
+/*  Sleep (idle mode) until tick
+ *  @brief: Timer1 compare A is set to wake the CPU at tick, other interrupts
+ *          (display scan, tone) wake it earlier and it goes back to sleep.
+ *          Interrupts are off between the check and sleep_cpu(), an interrupt
+ *          arriving in between wakes the CPU straight after it sleeps
+ */
+static void idle_until(timer_tick_t tick)
+{
+	OCR1A = tick;
+
+	while (1)
+	{
+		cli();
+
+		if (timer_due_p(tick))
+		{
+			sei();
+			return;
+		}
+
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+	}
+}
+
+
+/*  Run task table until power off
+ *  @param tasks: task table, see task.h
+ *  @param num_tasks: number of entries in tasks
+ *  @brief: Same selection as task_schedule() over the enabled tasks (overdue
+ *          tasks run first), sleeping until the next one is due. Every run is
+ *          timed on the scheduler timer and recorded in task_stats.
+ *          Selection only uses scheduled times, see hal_tasks_enable()
+ */
+void hal_run(task_t *tasks, uint8_t num_tasks)
+{
+	uint8_t      i;
+	uint8_t      enabled = 0;
+	timer_tick_t now, end, scheduled;
+
+	timer_init();
+	scheduled = timer_get();
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	TIMSK1 |= BIT(OCIE1A);
+
+	while (1)
+	{
+		task_t       *next_task = NULL;
+		timer_tick_t sleep_min  = (timer_tick_t) ~0;
+
+		now = timer_get();
+
+		// Find the enabled task that needs to be run next
+		for (i = 0; i < num_tasks; i++)
+		{
+			timer_tick_t sleep;
+
+			if (!(tasks_enabled & BIT(i)))
+			{
+				continue;
+			}
+
+			if (!(enabled & BIT(i)))                   // Just enabled, due now
+			{
+				tasks[i].reschedule = scheduled;
+			}
+
+			sleep = tasks[i].reschedule - now;
+
+			if (sleep > (timer_tick_t) ~0 / 2)          // Overdue
+			{
+				sleep = 0;
+			}
+
+			if (sleep < sleep_min)
+			{
+				sleep_min = sleep;
+				next_task = &tasks[i];
+			}
+		}
+		enabled = tasks_enabled;
+
+		if (next_task == NULL)                         // Nothing enabled, wait for an interrupt
+		{
+			sleep_mode();
+			continue;
+		}
+
+		idle_until(next_task->reschedule);
+
+		now = timer_get();
+		next_task->func(next_task->data);
+		end = timer_get();
+
+		task_stats_record(next_task - tasks, next_task->period, now - next_task->reschedule, end - now);
+		scheduled              = next_task->reschedule;   // Tasks it enabled start from here
+		next_task->reschedule += next_task->period;
+	}
+}
+
+
+/*  Select which task table entries hal_run() runs (all by default)
+ *  @param mask: bit n enables tasks[n]
+ */
+void hal_tasks_enable(uint8_t mask)
+{
+	tasks_enabled = mask;
+}
+
+
+/*  Returns scheduler clock (TASK_RATE ticks per second, wraps)
+ */
+task_tick_t hal_clock(void)
+{
+	return timer_get();
+}
+
+
+/*  Apply display changes and advance any scrolling text
+ *  @brief: the LED matrix is refreshed by a timer interrupt, not by this call
+ */
+void hal_display_update(void)
+{
+	tinygl_update();
+}
+
+
+/*  Clear display and stop any scrolling text
+ */
+void hal_display_clear(void)
+{
+	tinygl_clear();
+}
+
+
+/*  Double buffered frames, see display_back_get()
+ */
+uint8_t *hal_frame_back(void)
+{
+	return display_back_get();
+}
+
+
+void hal_frame_swap(void)
+{
+	display_swap();
+}
+
+
+/*  Configure scrolling text (3x5 font, rotated)
+ *  @param message_rate: text scroll speed
+ */
+void hal_text_init(uint8_t message_rate)
+{
+	tinygl_text_speed_set(message_rate);
+	tinygl_font_set(&font3x5_1);
+	tinygl_text_mode_set(TINYGL_TEXT_MODE_SCROLL);
+	tinygl_text_dir_set(TINYGL_TEXT_DIR_ROTATE);
+}
+
+
+/*  Scroll message across display
+ *  @param message: string to display, copied by tinygl
+ */
+void hal_text(const char *message)
+{
+	tinygl_text(message);
+}
+
+
+/*  Sample navswitch/button, must be called before checking for push events
+ *  @brief: the navswitch directions share port C bits 4-7 with the LED
+ *          matrix rows, the column scan is held while they are switched to
+ *          pull-up inputs and read so it can't drive them in between
+ */
+void hal_navswitch_update(void)
+{
+	display_scan_hold();
+	navswitch_update();
+	display_scan_release();
+}
+
+
+void hal_button_update(void)
+{
+	button_update();
+}
+
+
+/*  Returns true if input was pushed since last update
+ *  @param input: INPUT_NORTH..INPUT_PUSH for navswitch
+ */
+bool hal_navswitch_push_event_p(HAL_INPUT_t input)
+{
+	return navswitch_push_event_p(input);             // HAL_INPUT_t follows navswitch ordering
+}
+
+
+bool hal_button_push_event_p(void)
+{
+	return button_push_event_p(0);
+}
+
+
+/*  Turn blue LED on/off
+ */
+void hal_led_set(bool state)
+{
+	led_set(LED1, state);
+}
+
+
+/*  Configure speaker pins and Timer0 (CTC, interrupt on compare match A)
+ */
+void hal_tone_init(void)
+{
+	pio_config_set(SPEAKER_PIN1, PIO_OUTPUT_LOW);
+	pio_config_set(SPEAKER_PIN2, PIO_OUTPUT_LOW);
+	mixer_init(&mixer);
+
+	TCCR0A = BIT(WGM01);
+	TCCR0B = 0;                                       // Stopped until a note is played
+	TIMSK0 = BIT(OCIE0A);
+	sei();
+}
+
+
+/*  Toggle both speaker pins every half period (one voice), or output the
+ *  next mixer sample (both voices)
+ *  @brief: The pins are always in anti-phase, writing PIND toggles
+ *          both PORTD bits in one instruction
+ */
+ISR(TIMER0_COMPA_vect)
+{
+	MIXER_OUTPUT_t sample;
+
+	if (!tone_mixing)
+	{
+		PIND = SPEAKER_MASK;
+		return;
+	}
+
+	sample = mixer_sample(&mixer);
+
+	if ((sample != MIXER_OFF) && ((sample == MIXER_HIGH) != speaker_high))
+	{
+		PIND         = SPEAKER_MASK;
+		speaker_high = !speaker_high;
+	}
+}
+
+
+/*  Restart Timer0 with the speaker pins in anti-phase
+ *  @param top: OCR0A, clock: clock select
+ */
+static void tone_start(uint8_t top, uint8_t clock)
+{
+	TCCR0B       = 0;
+	OCR0A        = top;
+	TCNT0        = 0;
+	speaker_high = true;
+	pio_output_high(SPEAKER_PIN1);                    // Start in anti-phase
+	pio_output_low(SPEAKER_PIN2);
+	TCCR0B       = clock;
+}
+
+
+/*  Play one note, the interrupt toggles the pins every half period
+ *  @param note: MIDI note number, 0 for silence
+ *  @brief: Picks the smallest prescaler the half period fits in 8 bits with
+ */
+static void tone_single_set(uint8_t note)
+{
+	uint32_t cycles;
+	uint8_t  octave = note / 12;
+	uint8_t  clock  = 0;
+
+	if (note == tone_single)
+	{
+		return;                                       // Already playing, no phase glitch
+	}
+
+	tone_single = note;
+
+	if (note == 0)
+	{
+		TCCR0B = 0;
+		PORTD &= ~SPEAKER_MASK;                       // No DC across the piezo
+		return;
+	}
+
+	cycles = pgm_read_word(&TONE_HALF_PERIODS[note % 12]);
+	cycles = (octave > TONE_OCTAVE) ? cycles >> (octave - TONE_OCTAVE) : cycles << (TONE_OCTAVE - octave);
+
+	while ((clock < ARRAY_SIZE(TONE_PRESCALER_SHIFTS) - 1) && ((cycles >> TONE_PRESCALER_SHIFTS[clock]) > 256))
+	{
+		clock++;
+	}
+	cycles >>= TONE_PRESCALER_SHIFTS[clock];
+
+	tone_start((cycles > 256) ? 255 : (cycles ? cycles - 1 : 0), clock + 1);
+}
+
+
+/*  Play a note on one voice of the piezo speaker
+ *  @param voice: 0..HAL_VOICES-1
+ *  @param note: MIDI note number, 0 for silence
+ *  @brief: While one voice sounds, Timer0 toggles the pins every half
+ *          period of its note (an interrupt per toggle, exact pitch).
+ *          The sample interrupt (mixer.h) only runs while both voices sound
+ */
+void hal_tone_set(uint8_t voice, uint8_t note)
+{
+	uint16_t step = mixer_note_step(note);
+
+	if (voice >= HAL_VOICES)
+	{
+		return;
+	}
+
+	tone_notes[voice] = step ? note : 0;              // Same range as the mixer
+
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		mixer.step[voice] = step;
+	}
+
+	if (tone_notes[0] && tone_notes[1])
+	{
+		if (!tone_mixing)
+		{
+			tone_mixing = true;
+			tone_single = 0;
+			tone_start(TONE_MIX_TOP, TONE_MIX_CLOCK);
+		}
+		return;
+	}
+
+	if (tone_mixing)
+	{
+		TCCR0B      = 0;
+		tone_mixing = false;
+	}
+
+	tone_single_set(tone_notes[0] | tone_notes[1]);   // At most one is non-zero
+}
+
+
+/*  Read EEPROM, waits for a write in progress (avr-libc)
+ */
+void hal_eeprom_read(uint16_t address, void *data, uint16_t length)
+{
+	eeprom_read_block(data, (const void *)(uintptr_t)address, length);
+}
+
+
+/*  Write a byte of EEPROM, only the start of the write is waited for
+ */
+bool hal_eeprom_ready_p(void)
+{
+	return eeprom_is_ready();
+}
+
+
+void hal_eeprom_write_byte(uint16_t address, uint8_t value)
+{
+	eeprom_write_byte((uint8_t *)(uintptr_t)address, value);
+}
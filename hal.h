@@ -0,0 +1,146 @@
+/** @file   hal.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Hardware abstraction layer
+ *          Every game module reaches the board through these functions.
+ *          hal.c drives the UCFK4 drivers, host/hal_host.c is the headless
+ *          Linux backend (framebuffer, scripted input, audio sink, virtual clock)
+ */
+
+#ifndef HAL_H
+#define HAL_H
+
+#include "system.h"
+#include "task.h"
+
+// Display dimensions (pixels)
+#define HAL_DISPLAY_WIDTH     LEDMAT_COLS_NUM
+#define HAL_DISPLAY_HEIGHT    LEDMAT_ROWS_NUM
+#define HAL_VOICES            2                 // Tones that can play at once
+#define HAL_EEPROM_SIZE       1024              // Bytes of EEPROM (ATmega32U2)
+
+
+// Player inputs, navswitch directions follow navswitch.h ordering
+typedef enum
+{
+	INPUT_NORTH = 0,
+	INPUT_EAST,
+	INPUT_SOUTH,
+	INPUT_WEST,
+	INPUT_PUSH,
+	INPUT_BUTTON
+} HAL_INPUT_t;
+
+
+/*  Initialise board (system clock, display, inputs, LED)
+ *  @param display_rate: rate hal_display_update() is called in hz
+ */
+void hal_init(uint16_t display_rate);
+
+
+/*  Run task table until power off (board) or run limit (host)
+ *  @param tasks: task table, see task.h
+ *  @param num_tasks: number of entries in tasks
+ *  @brief: between tasks the CPU sleeps (idle mode) until the next
+ *          enabled task is due or an interrupt needs handling
+ */
+void hal_run(task_t *tasks, uint8_t num_tasks);
+
+
+/*  Select which task table entries hal_run() runs (all by default)
+ *  @param mask: bit n enables tasks[n]
+ *  @brief: disabled tasks are skipped and cost nothing, a task that is
+ *          enabled again is due straight away (missed runs aren't caught up).
+ *          Its schedule starts at the scheduled time of the task that enabled
+ *          it, not the clock, so while no deadline is missed the order tasks
+ *          run in doesn't depend on how long they took (replays play the same
+ *          on the board and the host)
+ */
+void hal_tasks_enable(uint8_t mask);
+
+
+/*  Returns scheduler clock (TASK_RATE ticks per second, wraps)
+ */
+task_tick_t hal_clock(void);
+
+
+/*  Apply display changes and advance any scrolling text
+ *  @brief: the LED matrix is refreshed by a timer interrupt, not by this call
+ */
+void hal_display_update(void);
+
+
+/*  Clear display and stop any scrolling text
+ */
+void hal_display_clear(void);
+
+
+/*  Double buffered frames
+ *  @brief: hal_frame_back() returns HAL_DISPLAY_WIDTH bytes (bit n of byte x is
+ *          pixel x, n) not being displayed, hal_frame_swap() displays them.
+ *          The swap is a single byte write, the display never shows half a frame
+ */
+uint8_t *hal_frame_back(void);
+void hal_frame_swap(void);
+
+
+/*  Configure scrolling text (3x5 font, rotated)
+ *  @param message_rate: text scroll speed
+ */
+void hal_text_init(uint8_t message_rate);
+
+
+/*  Scroll message across display
+ *  @param message: string to display, copied by the HAL
+ */
+void hal_text(const char *message);
+
+
+/*  Sample navswitch/button, must be called before checking for push events
+ */
+void hal_navswitch_update(void);
+void hal_button_update(void);
+
+
+/*  Returns true if input was pushed since last update
+ *  @param input: INPUT_NORTH..INPUT_PUSH for navswitch
+ */
+bool hal_navswitch_push_event_p(HAL_INPUT_t input);
+bool hal_button_push_event_p(void);
+
+
+/*  Turn blue LED on/off
+ */
+void hal_led_set(bool state);
+
+
+/*  Configure speaker pins and play a tone on the piezo (push/pull)
+ *  @param voice: 0..HAL_VOICES-1, voices sound together
+ *  @param note: MIDI note number (69 is A4, 440 Hz), 0 for silence
+ *  @brief: One voice is a timer interrupt per half period, both voices are
+ *          mixed by a sample interrupt (see mixer.h) until one stops.
+ *          The CPU is only needed by the game when a note changes
+ */
+void hal_tone_init(void);
+void hal_tone_set(uint8_t voice, uint8_t note);
+
+
+/*  Read EEPROM
+ *  @param address: first byte, 0..HAL_EEPROM_SIZE-1
+ *  @param data: buffer, length: bytes
+ *  @brief: waits for a write in progress to finish
+ */
+void hal_eeprom_read(uint16_t address, void *data, uint16_t length);
+
+
+/*  Write a byte of EEPROM without waiting for it (see storage.h)
+ *  @param address: 0..HAL_EEPROM_SIZE-1, value: byte to write
+ *  @brief: The write takes about 3.3 ms on the board, hal_eeprom_ready_p()
+ *          is false until it is done. Writing while not ready waits
+ */
+bool hal_eeprom_ready_p(void);
+void hal_eeprom_write_byte(uint16_t address, uint8_t value);
+
+
+
+#endif
@@ -0,0 +1,122 @@
+/** @file   highscore.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Best score of each gamemode, kept in EEPROM
+ */
+
+#include "system.h"
+#include "highscore.h"
+#include "storage.h"
+#include "hal.h"
+#include <stddef.h>
+
+#define CRC8_POLYNOMIAL    0x07
+
+
+static HighscoreRecordStruct record;            // Newest record, written from by storage.c
+static uint8_t               slot;              // Slot of record
+
+
+/*  Returns EEPROM address of a slot
+ */
+static uint16_t slot_address(uint8_t index)
+{
+	return HIGHSCORE_EEPROM_ADDRESS + index * sizeof(HighscoreRecordStruct);
+}
+
+
+/*  Returns CRC-8 of a record, erased (0xFF) and blank (0x00) slots never match
+ */
+static uint8_t record_checksum(const HighscoreRecordStruct *entry)
+{
+	const uint8_t *bytes = (const uint8_t *)entry;
+	uint8_t       crc    = 0xFF;
+	uint8_t       index, bit;
+
+	for (index = 0; index < offsetof(HighscoreRecordStruct, checksum); index++)
+	{
+		crc ^= bytes[index];
+
+		for (bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x80) ? (crc << 1) ^ CRC8_POLYNOMIAL : crc << 1;
+		}
+	}
+
+	return crc;
+}
+
+
+/*  Load the newest valid record (all best scores 0 if there is none)
+ *  @brief: reads every slot once, sequence numbers are compared as
+ *          differences so they can wrap
+ */
+void highscore_init(void)
+{
+	HighscoreRecordStruct entry;
+	uint8_t               index;
+	bool                  found = false;
+
+	record = (HighscoreRecordStruct){
+		.sequence = 0
+	};
+	slot = HIGHSCORE_SLOTS - 1;                 // First record goes in slot 0
+
+	for (index = 0; index < HIGHSCORE_SLOTS; index++)
+	{
+		hal_eeprom_read(slot_address(index), &entry, sizeof(entry));
+
+		if (entry.checksum != record_checksum(&entry))
+		{
+			continue;
+		}
+
+		if (!found || ((int16_t)(entry.sequence - record.sequence) > 0))
+		{
+			record = entry;
+			slot   = index;
+			found  = true;
+		}
+	}
+}
+
+
+/*  Returns best score of a gamemode
+ */
+uint8_t highscore_best(uint8_t mode)
+{
+	return (mode < DIFFERENT_GAMEMODES) ? record.scores[mode] : 0;
+}
+
+
+/*  Record a finished game, a new best score is written to the next slot
+ *  @brief: the write is queued (storage_update() writes it over the next
+ *          few game ticks), a game can't end again before it is done.
+ *          If the queue is full the score is only kept in RAM, the slot and
+ *          sequence are left for the next new best (which writes every score)
+ */
+bool highscore_submit(uint8_t mode, uint8_t score)
+{
+	uint8_t next_slot = (slot + 1) % HIGHSCORE_SLOTS;
+
+	if ((mode >= DIFFERENT_GAMEMODES) || (score <= record.scores[mode]))
+	{
+		return false;
+	}
+
+	record.scores[mode] = score;
+	record.sequence++;
+	record.checksum     = record_checksum(&record);
+
+	if (storage_write(slot_address(next_slot), &record, sizeof(record)))
+	{
+		slot = next_slot;
+	}
+	else
+	{
+		record.sequence--;
+		record.checksum = record_checksum(&record);
+	}
+
+	return true;
+}
@@ -0,0 +1,51 @@
+/** @file   highscore.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Best score of each gamemode, kept in EEPROM
+ *          The table is stored as a rotating log of HIGHSCORE_SLOTS records,
+ *          each holding the whole table, a sequence number and a checksum.
+ *          A new best score writes the next slot, so each slot is only
+ *          written every HIGHSCORE_SLOTS new best scores (wear levelling).
+ *          On boot the valid record with the highest sequence number is used,
+ *          a record cut short by a reset fails its checksum and the one
+ *          before it is used instead. Writes go through storage.h.
+ */
+
+#ifndef HIGHSCORE_H
+#define HIGHSCORE_H
+
+#include "system.h"
+#include "game_manager.h"
+
+#define HIGHSCORE_EEPROM_ADDRESS    256
+#define HIGHSCORE_SLOTS             32         // Records in the log
+
+
+// One record of the log, checksum is written last
+typedef struct
+{
+	uint16_t sequence;                          // Higher is newer
+	uint8_t  scores[DIFFERENT_GAMEMODES];       // Indexed by GAMEMODES_t
+	uint8_t  checksum;                          // CRC-8 of the bytes before it
+} HighscoreRecordStruct;
+
+
+/*  Load the newest valid record (all best scores 0 if there is none)
+ */
+void highscore_init(void);
+
+
+/*  Returns best score of a gamemode
+ *  @param mode: GAMEMODES_t
+ */
+uint8_t highscore_best(uint8_t mode);
+
+
+/*  Record a finished game, a new best score is written to the next slot
+ *  @param mode: GAMEMODES_t, score: final score
+ *  @return true if score is a new best
+ */
+bool highscore_submit(uint8_t mode, uint8_t score);
+
+
+#endif
@@ -0,0 +1,20 @@
+/** @file   pgmspace.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Host stand-in for avr-libc <avr/pgmspace.h>
+ *          Flash and RAM share one address space on the host
+ */
+
+#ifndef PGMSPACE_H
+#define PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(ADDRESS)    (*(const uint8_t *)(ADDRESS))
+#define pgm_read_word(ADDRESS)    (*(const uint16_t *)(ADDRESS))
+#define memcpy_P(DEST, SRC, N)    memcpy((DEST), (SRC), (N))
+
+
+#endif
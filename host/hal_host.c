@@ -0,0 +1,553 @@
+/** @file   hal_host.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Hardware abstraction layer (headless Linux backend)
+ *          In-memory framebuffer, scripted input queue,
+ *          note sequence audio sink (with PCM render) and virtual clock
+ */
+
+#include <string.h>
+#include "system.h"
+#include "hal.h"
+#include "hal_host.h"
+#include "task_stats.h"
+#include "mixer.h"
+
+// Scripted input event
+typedef struct
+{
+	uint32_t    tick;
+	HAL_INPUT_t input;
+} HostInputStruct;
+
+
+// Virtual clock
+static uint32_t now       = 0;
+static uint32_t run_limit = UINT32_MAX;
+static bool     stopped   = false;
+
+// Simulated execution time of each task table entry
+static uint16_t task_costs[TASK_STATS_MAX];
+static uint8_t  tasks_enabled = 0xFF;         // Bit n enables tasks[n]
+static uint32_t busy          = 0;            // Ticks spent running tasks (not idle)
+
+// Display, front and back framebuffers
+static uint8_t framebuffers[2][HAL_DISPLAY_WIDTH];
+static uint8_t front = 0;
+static char    text[HAL_HOST_TEXT_SIZE];
+static bool    led_state = false;
+
+// Input queue and events pending since last update (bitmap of HAL_INPUT_t)
+static HostInputStruct input_queue[HAL_HOST_INPUT_QUEUE_SIZE];
+static uint16_t        input_head = 0;
+static uint16_t        input_tail = 0;
+static uint8_t         navswitch_events;
+static uint8_t         button_events;
+
+// EEPROM, erased (0xFF) until an image is loaded
+static uint8_t eeprom[HAL_EEPROM_SIZE] = { [0 ... HAL_EEPROM_SIZE - 1] = 0xFF };
+
+// Audio sink, PCM is rendered up to the current tick before each note change
+static uint8_t     tone_notes[HAL_VOICES];
+static uint32_t    tone_changes = 0;
+static FILE        *audio_log   = NULL;
+static FILE        *pcm_file    = NULL;
+static MixerStruct mixer;
+static uint64_t    pcm_samples  = 0;          // Samples rendered so far
+
+
+/*  Reset virtual clock, display, input queue, audio counters and task_stats
+ */
+void hal_host_reset(void)
+{
+	now              = 0;
+	busy             = 0;
+	tasks_enabled    = 0xFF;
+	stopped          = false;
+	input_head       = 0;
+	input_tail       = 0;
+	navswitch_events = 0;
+	button_events    = 0;
+	tone_changes     = 0;
+	pcm_samples      = 0;
+	memset(tone_notes, 0, sizeof(tone_notes));
+	mixer_init(&mixer);
+	led_state        = false;
+	front            = 0;
+	hal_display_clear();
+	task_stats_reset();
+}
+
+
+/*  Queue an input event
+ *  @param tick: virtual clock tick the input is pushed at
+ *  @param input: navswitch direction/push or button
+ *  @return false if queue is full or tick is earlier than the last queued event
+ */
+bool hal_host_input_push(uint32_t tick, HAL_INPUT_t input)
+{
+	if ((input_tail == HAL_HOST_INPUT_QUEUE_SIZE) ||
+	    ((input_tail > 0) && (tick < input_queue[input_tail - 1].tick)))
+	{
+		return false;
+	}
+
+	input_queue[input_tail++] = (HostInputStruct){
+		.tick = tick, .input = input
+	};
+	return true;
+}
+
+
+/*  Queue input events from a script
+ *  @param file: lines of "<tick> <N|E|S|W|P|B>", '#' starts a comment
+ *  @return false on malformed line (events before it are kept)
+ */
+bool hal_host_script_load(FILE *file)
+{
+	static const char INPUT_CODES[] = "NESWPB";     // HAL_INPUT_t order
+	char              line[64];
+
+	while (fgets(line, sizeof(line), file))
+	{
+		unsigned long tick;
+		char          code;
+		const char    *input;
+
+		if ((line[0] == '#') || (line[strspn(line, " \t\r\n")] == '\0'))
+		{
+			continue;
+		}
+
+		if ((sscanf(line, "%lu %c", &tick, &code) != 2) ||
+		    ((input = strchr(INPUT_CODES, code)) == NULL) ||
+		    !hal_host_input_push(tick, (HAL_INPUT_t)(input - INPUT_CODES)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/*  Limit virtual time hal_run() executes for
+ *  @param ticks: hal_run() returns once the virtual clock reaches ticks
+ */
+void hal_host_run_limit_set(uint32_t ticks)
+{
+	run_limit = ticks;
+}
+
+
+/*  Set how long a task takes to run on the virtual clock (default 0)
+ *  @param index: task table index, entries past TASK_STATS_MAX always take 0
+ *  @param ticks: virtual clock ticks the clock advances by after each run
+ */
+void hal_host_task_cost_set(uint8_t index, uint16_t ticks)
+{
+	if (index < TASK_STATS_MAX)
+	{
+		task_costs[index] = ticks;
+	}
+}
+
+
+/*  Make hal_run() return after the current task
+ */
+void hal_host_stop(void)
+{
+	stopped = true;
+}
+
+
+/*  Returns current virtual clock tick
+ */
+uint32_t hal_host_now(void)
+{
+	return now;
+}
+
+
+/*  Returns virtual clock ticks spent running tasks (the rest is idle)
+ */
+uint32_t hal_host_busy(void)
+{
+	return busy;
+}
+
+
+/*  Returns framebuffer, one byte per column, bit n is row n
+ */
+const uint8_t *hal_host_framebuffer(void)
+{
+	return framebuffers[front];
+}
+
+
+/*  Returns message currently scrolling (empty if display cleared)
+ */
+const char *hal_host_text(void)
+{
+	return text;
+}
+
+
+/*  Returns LED state
+ */
+bool hal_host_led(void)
+{
+	return led_state;
+}
+
+
+/*  Returns note currently playing on a voice (0 for silence)
+ */
+uint8_t hal_host_tone(uint8_t voice)
+{
+	return (voice < HAL_VOICES) ? tone_notes[voice] : 0;
+}
+
+
+/*  Returns number of hal_tone_set() calls
+ */
+uint32_t hal_host_tone_changes(void)
+{
+	return tone_changes;
+}
+
+
+/*  Record notes played as "<tick> <voice> <note>" lines
+ *  @param file: output file, NULL for null sink
+ */
+void hal_host_audio_log_set(FILE *file)
+{
+	audio_log = file;
+}
+
+
+/*  Render mixer output up to the current tick
+ *  @brief: Same mixer as the board's sample interrupt, HIGH/LOW are the two
+ *          push/pull states of the piezo and OFF is no voltage across it.
+ *          A single voice goes through it too, the board toggles that one
+ *          at its exact half period instead
+ */
+void hal_host_pcm_flush(void)
+{
+	static const uint8_t LEVELS[] = { [MIXER_OFF] = 128, [MIXER_LOW] = 64, [MIXER_HIGH] = 192 };
+	uint64_t             end      = (uint64_t)now * MIXER_SAMPLE_RATE / TASK_RATE;
+
+	if (!pcm_file)
+	{
+		return;
+	}
+
+	for (; pcm_samples < end; pcm_samples++)
+	{
+		fputc(LEVELS[mixer_sample(&mixer)], pcm_file);
+	}
+}
+
+
+/*  Render the speaker output as raw PCM
+ *  @param file: output file (unsigned 8 bit, mono, MIXER_SAMPLE_RATE hz), NULL for none
+ */
+void hal_host_pcm_set(FILE *file)
+{
+	pcm_file = file;
+}
+
+
+/*  Nothing to set up on the host
+ *  @param display_rate: unused, display is always up to date
+ */
+void hal_init(__unused__ uint16_t display_rate)
+{
+}
+
+
+/*  Run task table against the virtual clock
+ *  @brief: Same selection as the board's hal_run() but instead of sleeping
+ *          the clock jumps straight to the next due task, so the game runs
+ *          as fast as the CPU allows. Tasks run in zero time unless given
+ *          a cost (hal_host_task_cost_set()), overdue tasks run first.
+ *          Every run is recorded in task_stats.
+ *          Returns at run limit or hal_host_stop()
+ */
+void hal_run(task_t *tasks, uint8_t num_tasks)
+{
+	uint8_t     i, index;
+	uint8_t     enabled   = 0;
+	uint32_t    start;
+	task_tick_t scheduled = (task_tick_t)now;
+
+	stopped = false;
+
+	while (!stopped)
+	{
+		task_t      *next_task = NULL;
+		task_tick_t sleep_min  = (task_tick_t) ~0;
+
+		// Find the enabled task that needs to be run next
+		for (i = 0; i < num_tasks; i++)
+		{
+			task_tick_t sleep;
+
+			if (!(tasks_enabled & BIT(i)))
+			{
+				continue;
+			}
+
+			if (!(enabled & BIT(i)))                       // Just enabled, due now
+			{
+				tasks[i].reschedule = scheduled;
+			}
+
+			sleep = tasks[i].reschedule - (task_tick_t)now;
+
+			if (sleep > (task_tick_t) ~0 / 2)              // Overdue
+			{
+				sleep = 0;
+			}
+
+			if (sleep < sleep_min)
+			{
+				sleep_min = sleep;
+				next_task = &tasks[i];
+			}
+		}
+		enabled = tasks_enabled;
+
+		if ((next_task == NULL) || (now >= run_limit) || (run_limit - now <= sleep_min))
+		{
+			now = (now > run_limit) ? now : run_limit;
+			break;
+		}
+
+		now  += sleep_min;
+		start = now;
+		index = next_task - tasks;
+		next_task->func(next_task->data);
+
+		if (index < TASK_STATS_MAX)
+		{
+			now += task_costs[index];
+		}
+
+		busy += now - start;
+		task_stats_record(index, next_task->period, (task_tick_t)start - next_task->reschedule, now - start);
+		scheduled              = next_task->reschedule;   // Tasks it enabled start from here
+		next_task->reschedule += next_task->period;
+	}
+}
+
+
+/*  Select which task table entries hal_run() runs (all by default)
+ *  @param mask: bit n enables tasks[n]
+ */
+void hal_tasks_enable(uint8_t mask)
+{
+	tasks_enabled = mask;
+}
+
+
+/*  Returns virtual clock (TASK_RATE ticks per second, wraps)
+ */
+task_tick_t hal_clock(void)
+{
+	return (task_tick_t)now;
+}
+
+
+/*  Display is always up to date on the host
+ */
+void hal_display_update(void)
+{
+}
+
+
+/*  Clear framebuffer and text
+ */
+void hal_display_clear(void)
+{
+	memset(framebuffers[front], 0, sizeof(framebuffers[front]));
+	text[0] = '\0';
+}
+
+
+/*  Double buffered frames
+ */
+uint8_t *hal_frame_back(void)
+{
+	return framebuffers[!front];
+}
+
+
+void hal_frame_swap(void)
+{
+	front = !front;
+}
+
+
+/*  Text is recorded, not rendered
+ */
+void hal_text_init(__unused__ uint8_t message_rate)
+{
+}
+
+
+void hal_text(const char *message)
+{
+	strncpy(text, message, HAL_HOST_TEXT_SIZE - 1);
+	text[HAL_HOST_TEXT_SIZE - 1] = '\0';
+}
+
+
+/*  Move scripted inputs that are due into pending events
+ *  @param mask: inputs belonging to the device being updated
+ *  @return bitmap of due inputs in mask
+ */
+static uint8_t input_collect(uint8_t mask)
+{
+	uint8_t  events = 0;
+	uint16_t index;
+
+	// Due events for this device are consumed, others are left for the other device
+	for (index = input_head; (index < input_tail) && (input_queue[index].tick <= now); index++)
+	{
+		uint8_t bit = BIT(input_queue[index].input);
+
+		if (bit & mask)
+		{
+			events                   |= bit;
+			input_queue[index].input  = INPUT_BUTTON + 1;          // Mark as consumed
+		}
+	}
+
+	// Drop consumed events from the front of the queue
+	while ((input_head < input_tail) && (input_queue[input_head].input > INPUT_BUTTON))
+	{
+		input_head++;
+	}
+
+	return events;
+}
+
+
+/*  Sample scripted navswitch/button input
+ */
+void hal_navswitch_update(void)
+{
+	navswitch_events = input_collect(BIT(INPUT_BUTTON) - 1);
+}
+
+
+void hal_button_update(void)
+{
+	button_events = input_collect(BIT(INPUT_BUTTON));
+}
+
+
+/*  Returns true if input was pushed since last update, event is consumed
+ *  @param input: INPUT_NORTH..INPUT_PUSH for navswitch
+ */
+bool hal_navswitch_push_event_p(HAL_INPUT_t input)
+{
+	bool pushed = (navswitch_events & BIT(input)) != 0;
+
+	navswitch_events &= ~BIT(input);
+	return pushed;
+}
+
+
+bool hal_button_push_event_p(void)
+{
+	bool pushed = button_events != 0;
+
+	button_events = 0;
+	return pushed;
+}
+
+
+/*  Record LED state
+ */
+void hal_led_set(bool state)
+{
+	led_state = state;
+}
+
+
+/*  Audio sink, records (and optionally logs and renders) the note sequence
+ */
+void hal_tone_init(void)
+{
+	memset(tone_notes, 0, sizeof(tone_notes));
+	mixer_init(&mixer);
+}
+
+
+void hal_tone_set(uint8_t voice, uint8_t note)
+{
+	if (voice >= HAL_VOICES)
+	{
+		return;
+	}
+
+	hal_host_pcm_flush();
+	tone_notes[voice] = note;
+	mixer.step[voice] = mixer_note_step(note);
+	tone_changes++;
+
+	if (audio_log)
+	{
+		fprintf(audio_log, "%lu %u %u\n", (unsigned long)now, voice, note);
+	}
+}
+
+
+/*  Read EEPROM image
+ *  @brief: bytes past HAL_EEPROM_SIZE read as erased
+ */
+void hal_eeprom_read(uint16_t address, void *data, uint16_t length)
+{
+	uint8_t *bytes = data;
+
+	for (; length > 0; length--, address++)
+	{
+		*bytes++ = (address < HAL_EEPROM_SIZE) ? eeprom[address] : 0xFF;
+	}
+}
+
+
+/*  Writes finish straight away on the host
+ */
+bool hal_eeprom_ready_p(void)
+{
+	return true;
+}
+
+
+void hal_eeprom_write_byte(uint16_t address, uint8_t value)
+{
+	if (address < HAL_EEPROM_SIZE)
+	{
+		eeprom[address] = value;
+	}
+}
+
+
+/*  Load/save the EEPROM image (raw HAL_EEPROM_SIZE bytes, as read from the board)
+ *  @param file: image, a short image leaves the rest erased
+ */
+void hal_host_eeprom_load(FILE *file)
+{
+	size_t length = fread(eeprom, 1, sizeof(eeprom), file);
+
+	memset(eeprom + length, 0xFF, sizeof(eeprom) - length);
+}
+
+
+bool hal_host_eeprom_save(FILE *file)
+{
+	return fwrite(eeprom, 1, sizeof(eeprom), file) == sizeof(eeprom);
+}
@@ -0,0 +1,112 @@
+/** @file   hal_host.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Controls for the headless Linux HAL backend
+ *          Scripted input, run limit, EEPROM image and inspection of the
+ *          framebuffer, text, LED and notes played
+ */
+
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include <stdio.h>
+#include "system.h"
+#include "hal.h"
+
+#define HAL_HOST_INPUT_QUEUE_SIZE    4096   // Maximum scripted input events
+#define HAL_HOST_TEXT_SIZE           32     // Matches tinygl message buffer
+
+
+/*  Reset virtual clock, display, input queue, audio counters and task_stats
+ */
+void hal_host_reset(void);
+
+
+/*  Queue an input event
+ *  @param tick: virtual clock tick the input is pushed at
+ *  @param input: navswitch direction/push or button
+ *  @return false if queue is full or tick is earlier than the last queued event
+ */
+bool hal_host_input_push(uint32_t tick, HAL_INPUT_t input);
+
+
+/*  Queue input events from a script
+ *  @param file: lines of "<tick> <N|E|S|W|P|B>", '#' starts a comment
+ *  @return false on malformed line (events before it are kept)
+ */
+bool hal_host_script_load(FILE *file);
+
+
+/*  Limit virtual time hal_run() executes for
+ *  @param ticks: hal_run() returns once the virtual clock reaches ticks
+ */
+void hal_host_run_limit_set(uint32_t ticks);
+
+
+/*  Set how long a task takes to run on the virtual clock (default 0)
+ *  @param index: task table index
+ *  @param ticks: virtual clock ticks the clock advances by after each run
+ */
+void hal_host_task_cost_set(uint8_t index, uint16_t ticks);
+
+
+/*  Make hal_run() return after the current task
+ */
+void hal_host_stop(void);
+
+
+/*  Returns current virtual clock tick
+ */
+uint32_t hal_host_now(void);
+
+
+/*  Returns virtual clock ticks spent running tasks (the rest is idle)
+ */
+uint32_t hal_host_busy(void);
+
+
+/*  Returns framebuffer, one byte per column, bit n is row n
+ */
+const uint8_t *hal_host_framebuffer(void);
+
+
+/*  Returns message currently scrolling (empty if display cleared)
+ */
+const char *hal_host_text(void);
+
+
+/*  Returns LED state
+ */
+bool hal_host_led(void);
+
+
+/*  Returns note currently playing on a voice (0 for silence)
+ *  and number of hal_tone_set() calls
+ */
+uint8_t hal_host_tone(uint8_t voice);
+uint32_t hal_host_tone_changes(void);
+
+
+/*  Record notes played as "<tick> <voice> <note>" lines (0 is silence)
+ *  @param file: output file, NULL for null sink
+ */
+void hal_host_audio_log_set(FILE *file);
+
+
+/*  Render the speaker output as raw PCM (unsigned 8 bit, mono, MIXER_SAMPLE_RATE hz)
+ *  @param file: output file, NULL for none
+ *  @brief: Output is rendered lazily, hal_host_pcm_flush() renders up to the current tick
+ */
+void hal_host_pcm_set(FILE *file);
+void hal_host_pcm_flush(void);
+
+
+/*  Load/save the EEPROM image (raw HAL_EEPROM_SIZE bytes, as read from the board)
+ *  @param file: image, a short image leaves the rest erased
+ *  @brief: The image is kept by hal_host_reset(), like the board's EEPROM
+ */
+void hal_host_eeprom_load(FILE *file);
+bool hal_host_eeprom_save(FILE *file);
+
+
+#endif
@@ -0,0 +1,211 @@
+/** @file   main.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Headless host runner
+ *          Runs game.c (compiled with main renamed to game_main) against
+ *          the virtual clock and prints the final display state
+ *
+ *  usage: game-host [-t ticks] [-s script] [-a audio_log] [-w pcm_file] [-c cost,cost,...] [-e eeprom]
+ *         -w: speaker output as raw PCM (unsigned 8 bit, mono, MIXER_SAMPLE_RATE hz)
+ *         -c: virtual clock ticks each task table entry takes to run
+ *         -e: EEPROM image, loaded before the run (if it exists) and saved after it
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "system.h"
+#include "task.h"
+#include "hal.h"
+#include "hal_host.h"
+#include "task_stats.h"
+#include "scroll.h"
+
+#define DEFAULT_RUN_SECONDS    60
+
+
+int game_main(void);
+
+
+/*  Set task costs from a comma separated list
+ *  @return false if list is malformed
+ */
+static bool task_costs_parse(const char *list)
+{
+	uint8_t index = 0;
+	char    *end;
+
+	while (*list)
+	{
+		hal_host_task_cost_set(index++, strtoul(list, &end, 0));
+
+		if ((end == list) || ((*end != ',') && (*end != '\0')))
+		{
+			return false;
+		}
+		list = (*end == ',') ? end + 1 : end;
+	}
+
+	return true;
+}
+
+
+/*  Prints scheduler statistics of every task that ran
+ */
+static void task_stats_print(void)
+{
+	uint8_t index;
+
+	printf("task   runs       run min/mean/max   late min/max   missed\n");
+
+	for (index = 0; index < TASK_STATS_MAX; index++)
+	{
+		const TaskStatsStruct *task = task_stats_get(index);
+
+		if (task->runs)
+		{
+			printf("%-6u %-10lu %3u/%5.1f/%-7u %5u/%-8u %u\n", index, (unsigned long)task->runs,
+			       task->run_min, (double)task->run_total / task->runs, task->run_max,
+			       task->late_min, task->late_max, task->missed);
+		}
+	}
+}
+
+
+/*  Prints framebuffer as rows of '#' (on) and '.' (off)
+ */
+static void framebuffer_print(void)
+{
+	const uint8_t *columns = hal_host_framebuffer();
+	uint8_t       x, y;
+
+	for (y = 0; y < HAL_DISPLAY_HEIGHT; y++)
+	{
+		for (x = 0; x < HAL_DISPLAY_WIDTH; x++)
+		{
+			putchar((columns[x] & BIT(y)) ? '#' : '.');
+		}
+		putchar('\n');
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	uint32_t        ticks   = DEFAULT_RUN_SECONDS * (uint32_t)TASK_RATE;
+	FILE            *script = NULL;
+	FILE            *audio  = NULL;
+	FILE            *pcm    = NULL;
+	const char      *eeprom = NULL;
+	FILE            *image;
+	struct timespec start, end;
+	double          elapsed;
+	int             option;
+
+	while ((option = getopt(argc, argv, "t:s:a:w:c:e:")) != -1)
+	{
+		switch (option)
+		{
+		case 't':
+			ticks = strtoul(optarg, NULL, 0);
+			break;
+
+		case 's':
+			script = fopen(optarg, "r");
+			if (!script)
+			{
+				perror(optarg);
+				return 1;
+			}
+			break;
+
+		case 'a':
+			audio = fopen(optarg, "w");
+			if (!audio)
+			{
+				perror(optarg);
+				return 1;
+			}
+			break;
+
+		case 'w':
+			pcm = fopen(optarg, "wb");
+			if (!pcm)
+			{
+				perror(optarg);
+				return 1;
+			}
+			break;
+
+		case 'c':
+			if (!task_costs_parse(optarg))
+			{
+				fprintf(stderr, "bad task costs\n");
+				return 1;
+			}
+			break;
+
+		case 'e':
+			eeprom = optarg;
+			break;
+
+		default:
+			fprintf(stderr, "usage: %s [-t ticks] [-s script] [-a audio_log] [-w pcm_file] [-c cost,cost,...] [-e eeprom]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	hal_host_reset();
+	hal_host_run_limit_set(ticks);
+	hal_host_audio_log_set(audio);
+	hal_host_pcm_set(pcm);
+
+	if (script && !hal_host_script_load(script))
+	{
+		fprintf(stderr, "bad input script\n");
+		return 1;
+	}
+
+	if (eeprom && ((image = fopen(eeprom, "rb")) != NULL))
+	{
+		hal_host_eeprom_load(image);
+		fclose(image);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	game_main();
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	hal_host_pcm_flush();
+
+	if (eeprom && (((image = fopen(eeprom, "wb")) == NULL) || !hal_host_eeprom_save(image) || fclose(image)))
+	{
+		perror(eeprom);
+		return 1;
+	}
+
+	elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+
+	framebuffer_print();
+	printf("text:          \"%s\"\n", *scroll_text() ? scroll_text() : hal_host_text());
+	printf("led:           %d\n", hal_host_led());
+	printf("tone:          %u %u (%lu changes)\n", hal_host_tone(0), hal_host_tone(1),
+	       (unsigned long)hal_host_tone_changes());
+	printf("ticks:         %lu (%.1f s virtual)\n", (unsigned long)hal_host_now(), (double)hal_host_now() / TASK_RATE);
+	printf("ticks/s:       %.0f\n", hal_host_now() / (elapsed > 0 ? elapsed : 1e-9));
+	printf("busy:          %lu (%.1f%%, idle the rest)\n", (unsigned long)hal_host_busy(),
+	       hal_host_now() ? 100.0 * hal_host_busy() / hal_host_now() : 0.0);
+	task_stats_print();
+
+	if (audio)
+	{
+		fclose(audio);
+	}
+
+	if (pcm)
+	{
+		fclose(pcm);
+	}
+
+	return 0;
+}
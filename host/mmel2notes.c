@@ -0,0 +1,245 @@
+/** @file   mmel2notes.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Build-time converter from mmelody text (sounds/NAME.mmel) to a note stream
+ *          The song is played through the real mmelody player at the
+ *          sound_update() rate and every callback is recorded, so the stream
+ *          has exactly the notes and timing mmelody would have produced.
+ *
+ *  usage: mmel2notes [-l] [-r rate] [-b bpm] song.mmel > song.notes
+ *         -l: song loops (as if followed by " :")
+ *
+ *  Output is a C initialiser fragment for a PROGMEM uint8_t array, see sound.h
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "system.h"
+#include "sound.h"
+#include "../../../extra/mmelody.h"
+
+#define MAX_SONG_LENGTH    2048
+#define MAX_EVENTS         4096
+#define MAX_SECONDS        600      // Longest song that can be converted
+#define END_MARKER         "C"      // Played after the song, its start marks the song's end
+#define LOOP_REST          " "      // Rest the game played before looping (" :")
+#define EVENTS_PER_LINE    8
+
+
+// Callback recorded from mmelody
+typedef struct
+{
+	uint32_t tick;
+	uint8_t  note;
+	uint8_t  volume;
+} NoteEventStruct;
+
+
+static NoteEventStruct events[MAX_EVENTS];
+static uint16_t        num_events = 0;
+static uint32_t        now        = 0;
+
+
+/*  mmelody callback, records note with current tick
+ */
+static void note_record(__unused__ void *data, uint8_t note, uint8_t volume)
+{
+	if (num_events < MAX_EVENTS)
+	{
+		events[num_events++] = (NoteEventStruct){
+			.tick = now, .note = note, .volume = volume
+		};
+	}
+}
+
+
+/*  Reads the concatenated string literals of a .mmel file, skipping comments
+ *  @return length of song, -1 on error
+ */
+static int song_read(FILE *file, char *song, int size)
+{
+	int  length    = 0;
+	int  ch, next;
+	bool in_string = false;
+
+	while ((ch = getc(file)) != EOF)
+	{
+		if (in_string)
+		{
+			if (ch == '"')
+			{
+				in_string = false;
+				continue;
+			}
+
+			if ((ch == '\\') && ((ch = getc(file)) == EOF))
+			{
+				return -1;
+			}
+
+			if (length >= size - 1)
+			{
+				return -1;
+			}
+			song[length++] = ch;
+		}
+		else if (ch == '"')
+		{
+			in_string = true;
+		}
+		else if (ch == '/')
+		{
+			next = getc(file);
+
+			if (next == '*')              // Skip block comment
+			{
+				for (ch = getc(file), next = getc(file); (next != EOF) && !((ch == '*') && (next == '/')); ch = next, next = getc(file))
+				{
+				}
+			}
+			else if (next == '/')         // Skip line comment
+			{
+				while (((ch = getc(file)) != EOF) && (ch != '\n'))
+				{
+				}
+			}
+			else
+			{
+				ungetc(next, file);
+			}
+		}
+	}
+
+	song[length] = '\0';
+	return in_string ? -1 : length;
+}
+
+
+/*  Prints one stream event
+ */
+static void event_print(uint8_t note, uint8_t ticks)
+{
+	static uint8_t column = 0;
+
+	printf("%3u, %3u,%s", note, ticks, (++column % EVENTS_PER_LINE) ? " " : "\n");
+}
+
+
+int main(int argc, char **argv)
+{
+	char          song[MAX_SONG_LENGTH + sizeof(LOOP_REST END_MARKER)];
+	mmelody_obj_t melody_info;
+	mmelody_t     melody;
+	uint16_t      rate     = SOUND_UPDATE_RATE;
+	uint16_t      bpm      = MELODY_BPM_DEFAULT;
+	bool          loop     = false;
+	uint8_t       velocity = 0;
+	uint16_t      index, end;
+	FILE          *file;
+	int           option;
+
+	while ((option = getopt(argc, argv, "lr:b:")) != -1)
+	{
+		switch (option)
+		{
+		case 'l':
+			loop = true;
+			break;
+
+		case 'r':
+			rate = strtoul(optarg, NULL, 0);
+			break;
+
+		case 'b':
+			bpm = strtoul(optarg, NULL, 0);
+			break;
+
+		default:
+			fprintf(stderr, "usage: %s [-l] [-r rate] [-b bpm] song.mmel\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if ((optind != argc - 1) || ((file = fopen(argv[optind], "r")) == NULL))
+	{
+		fprintf(stderr, "usage: %s [-l] [-r rate] [-b bpm] song.mmel\n", argv[0]);
+		return 1;
+	}
+
+	if (song_read(file, song, MAX_SONG_LENGTH) < 0)
+	{
+		fprintf(stderr, "%s: bad or too long song\n", argv[optind]);
+		return 1;
+	}
+	fclose(file);
+
+	strcat(song, loop ? LOOP_REST END_MARKER : END_MARKER);
+
+	// Play song through mmelody, recording every note it outputs
+	melody = mmelody_init(&melody_info, rate, note_record, NULL);
+	mmelody_speed_set(melody, bpm);
+	mmelody_play(melody, song);
+
+	for (now = 0; now < (uint32_t)MAX_SECONDS * rate; now++)
+	{
+		mmelody_update(melody);
+	}
+
+	// Song ends where the end marker (last note played) starts
+	for (end = num_events; (end > 0) && (events[end - 1].volume == 0); end--)
+	{
+	}
+
+	if (end < 2)
+	{
+		fprintf(stderr, "%s: no notes\n", argv[optind]);
+		return 1;
+	}
+	end--;
+
+	printf("/* Generated by mmel2notes from %s (%u Hz, %u bpm), do not edit */\n", argv[optind], rate, bpm);
+
+	for (index = 0; index < end; index++)
+	{
+		if (events[index].volume)
+		{
+			if (velocity && (velocity != events[index].volume))
+			{
+				fprintf(stderr, "%s: warning: volume changes are not kept\n", argv[optind]);
+			}
+			velocity = velocity ? velocity : events[index].volume;
+		}
+	}
+	printf("%u,\n", velocity);
+
+	for (index = 0; index < end; index++)
+	{
+		uint8_t  note     = events[index].volume ? events[index].note : SOUND_REST;
+		uint32_t duration = events[index + 1].tick - events[index].tick;
+
+		if (duration == 0)                    // Replaced within the same tick
+		{
+			continue;
+		}
+
+		// Merge following rests into this rest
+		while ((note == SOUND_REST) && (index + 1 < end) && (events[index + 1].volume == 0))
+		{
+			index++;
+			duration += events[index + 1].tick - events[index].tick;
+		}
+
+		// Durations longer than one byte are split
+		while (duration > UINT8_MAX)
+		{
+			event_print(note, UINT8_MAX);
+			duration -= UINT8_MAX;
+		}
+		event_print(note, duration);
+	}
+
+	printf("\n%u, 0\n", loop ? SOUND_LOOP : SOUND_END);
+	return 0;
+}
@@ -0,0 +1,403 @@
+/** @file   profile.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Whole-firmware cycle profiler (simavr)
+ *          Runs the real game.out in simavr with stand-ins for the board:
+ *          navswitch and button pins are driven from an input script, the
+ *          LED matrix, LED and speaker pins are watched. Every instruction's
+ *          cycles are charged to the function it belongs to, so the profile
+ *          covers everything on the board (tinygl, the task scheduler,
+ *          interrupts and sleep) and the lowest stack pointer gives the
+ *          stack high-water mark.
+ *
+ *  usage: profile -f game.out -y game.sym [-s script] [-t ticks]
+ *         -y: avr-nm -n output of the firmware (function addresses)
+ *         -s: input script, same format and ticks as game-host -s
+ *         -t: virtual clock ticks to run (TASK_RATE per second, like game-host)
+ *
+ *  Output is a tab separated flat profile, "<function> <calls> <cycles> <percent>"
+ *  sorted by cycles, after '#' summary lines.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_irq.h"
+#include "avr_ioport.h"
+
+// Board pins from the UCFK4 header the firmware is built with, see drivers/avr/pio.h
+enum { PORT_B, PORT_C, PORT_D };
+#define PIO_DEFINE(PORT, PORTBIT)    ((PORT) * 8 + (PORTBIT))
+#include "../../../drivers/avr/system.h"
+
+#define SPEAKER_PIO               PIO_DEFINE(PORT_D, 4)     // Same as SPEAKER_PIN1 in hal.c
+
+#define PROFILE_SCRIPT_RATE       10000     // Script ticks per second (host/task.h TASK_RATE)
+#define PROFILE_DEFAULT_TICKS     (60 * PROFILE_SCRIPT_RATE)
+#define PROFILE_PRESS_TICKS       (PROFILE_SCRIPT_RATE / 20)       // How long a scripted press is held
+#define PROFILE_MAX_EVENTS        4096
+#define PROFILE_NAME_SIZE         64
+#define PROFILE_SLEEP             "(sleep)"
+
+
+// Scripted press
+typedef struct
+{
+	uint64_t cycle;           // Pressed at
+	uint8_t  input;           // Index in INPUT_CODES
+} ProfileEventStruct;
+
+
+// Function in the firmware and the cycles charged to it
+typedef struct
+{
+	uint32_t address;         // Byte address in flash
+	char     name[PROFILE_NAME_SIZE];
+	uint64_t cycles;
+	uint32_t calls;
+} ProfileSymbolStruct;
+
+
+// Pins watched, and changes seen on each
+typedef struct
+{
+	const char *name;
+	uint8_t    pio;
+	uint32_t   changes;
+} ProfileWatchStruct;
+
+
+// Inputs in game-host script order, and their pins
+static const char    INPUT_CODES[] = "NESWPB";
+static const uint8_t INPUT_PIOS[]  =
+{
+	NAVSWITCH_NORTH_PIO, NAVSWITCH_EAST_PIO, NAVSWITCH_SOUTH_PIO,
+	NAVSWITCH_WEST_PIO, NAVSWITCH_PUSH_PIO, BUTTON1_PIO
+};
+#define INPUT_BUTTON              5                         // Active high, the navswitch is active low
+
+static ProfileWatchStruct watches[] =
+{
+	{ "speaker",       SPEAKER_PIO,     0 },
+	{ "ledmat_col1",   LEDMAT_COL1_PIO, 0 },
+	{ "ledmat_row1",   LEDMAT_ROW1_PIO, 0 },
+	{ "led",           LED1_PIO,        0 }
+};
+
+static ProfileEventStruct  events[PROFILE_MAX_EVENTS];
+static uint16_t            num_events  = 0;
+static ProfileSymbolStruct *symbols    = NULL;
+static uint32_t            num_symbols = 0;
+static uint32_t            data_end    = 0;                 // First byte past static data (__heap_start)
+static ProfileSymbolStruct sleeping    = { .name = PROFILE_SLEEP };
+
+
+/*  Returns simavr irq of a board pin
+ */
+static avr_irq_t *pin_irq(avr_t *avr, uint8_t pio)
+{
+	return avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B' + pio / 8), pio % 8);
+}
+
+
+/*  Sets a button/navswitch pin pressed or released
+ */
+static void input_set(avr_t *avr, uint8_t input, bool pressed)
+{
+	avr_raise_irq(pin_irq(avr, INPUT_PIOS[input]), (input == INPUT_BUTTON) ? pressed : !pressed);
+}
+
+
+/*  Counts changes of a watched output pin
+ */
+static void watch_notify(__unused__ avr_irq_t *irq, __unused__ uint32_t value, void *param)
+{
+	((ProfileWatchStruct *)param)->changes++;
+}
+
+
+/*  Loads input script, lines of "<tick> <N|E|S|W|P|B>", '#' starts a comment
+ *  @return false on malformed line
+ */
+static bool script_load(FILE *file, uint32_t frequency)
+{
+	char line[64];
+
+	while (fgets(line, sizeof(line), file))
+	{
+		unsigned long tick;
+		char          code;
+		const char    *input;
+
+		if ((line[0] == '#') || (line[strspn(line, " \t\r\n")] == '\0'))
+		{
+			continue;
+		}
+
+		if ((sscanf(line, "%lu %c", &tick, &code) != 2) ||
+		    ((input = strchr(INPUT_CODES, code)) == NULL) || (num_events == PROFILE_MAX_EVENTS))
+		{
+			return false;
+		}
+
+		events[num_events++] = (ProfileEventStruct){
+			.cycle = (uint64_t)tick * frequency / PROFILE_SCRIPT_RATE, .input = input - INPUT_CODES
+		};
+	}
+
+	return true;
+}
+
+
+/*  Adds a function to the profile
+ */
+static void symbol_add(uint32_t address, const char *name)
+{
+	if ((num_symbols & (num_symbols - 1)) == 0)       // Grow at powers of two
+	{
+		symbols = realloc(symbols, (num_symbols ? num_symbols * 2 : 1) * sizeof(*symbols));
+	}
+
+	symbols[num_symbols] = (ProfileSymbolStruct){ .address = address };
+	strncpy(symbols[num_symbols].name, name, PROFILE_NAME_SIZE - 1);
+	num_symbols++;
+}
+
+
+/*  Loads function addresses from "avr-nm -n" output
+ *  @return false if no functions were found
+ */
+static bool symbols_load(FILE *file)
+{
+	char          line[256];
+	unsigned long address;
+	char          type;
+	char          name[PROFILE_NAME_SIZE];
+
+	while (fgets(line, sizeof(line), file))
+	{
+		if (sscanf(line, "%lx %c %63s", &address, &type, name) != 3)
+		{
+			continue;
+		}
+
+		if (!strcmp(name, "__heap_start"))
+		{
+			data_end = address & 0xFFFF;              // Data addresses are offset by 0x800000
+		}
+
+		if ((type != 'T') && (type != 't'))
+		{
+			continue;
+		}
+
+		symbol_add(address, name);
+	}
+
+	return num_symbols > 0;
+}
+
+
+/*  Returns function containing a flash address (nm -n output is sorted)
+ */
+static ProfileSymbolStruct *symbol_find(uint32_t address)
+{
+	uint32_t low = 0, high = num_symbols;
+
+	while (high - low > 1)
+	{
+		uint32_t middle = (low + high) / 2;
+
+		if (symbols[middle].address <= address)
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return &symbols[low];
+}
+
+
+static int cycles_compare(const void *a, const void *b)
+{
+	const ProfileSymbolStruct *first = a, *second = b;
+
+	return (first->cycles < second->cycles) - (first->cycles > second->cycles);
+}
+
+
+/*  Prints summary and flat profile
+ */
+static void profile_print(const avr_t *avr, const char *firmware, uint16_t sp_min)
+{
+	uint32_t index;
+
+	printf("# firmware:   %s (%s, %lu Hz)\n", firmware, avr->mmcu, (unsigned long)avr->frequency);
+	printf("# cycles:     %llu (%.1f s)\n", (unsigned long long)avr->cycle, (double)avr->cycle / avr->frequency);
+	printf("# stack:      %u bytes high-water, %d bytes left above static data\n",
+	       avr->ramend - sp_min, data_end ? (int)sp_min + 1 - (int)data_end : -1);
+
+	for (index = 0; index < ARRAY_SIZE(watches); index++)
+	{
+		printf("# %-11s %lu changes\n", watches[index].name, (unsigned long)watches[index].changes);
+	}
+
+	symbol_add(0, sleeping.name);
+	symbols[num_symbols - 1].cycles = sleeping.cycles;
+	qsort(symbols, num_symbols, sizeof(*symbols), cycles_compare);
+
+	printf("function\tcalls\tcycles\tpercent\n");
+
+	for (index = 0; (index < num_symbols) && symbols[index].cycles; index++)
+	{
+		printf("%s\t%lu\t%llu\t%.2f\n", symbols[index].name, (unsigned long)symbols[index].calls,
+		       (unsigned long long)symbols[index].cycles, 100.0 * symbols[index].cycles / avr->cycle);
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	const char     *firmware_file = NULL;
+	FILE           *symbol_file   = NULL;
+	FILE           *script        = NULL;
+	uint32_t       ticks          = PROFILE_DEFAULT_TICKS;
+	elf_firmware_t firmware;
+	avr_t          *avr;
+	uint64_t       end, released[ARRAY_SIZE(INPUT_PIOS)] = { 0 };
+	uint16_t       next   = 0, sp_min = UINT16_MAX;
+	int            option, state = cpu_Running;
+	uint32_t       index;
+
+	while ((option = getopt(argc, argv, "f:y:s:t:")) != -1)
+	{
+		switch (option)
+		{
+		case 'f':
+			firmware_file = optarg;
+			break;
+
+		case 'y':
+			symbol_file = fopen(optarg, "r");
+			if (!symbol_file)
+			{
+				perror(optarg);
+				return 1;
+			}
+			break;
+
+		case 's':
+			script = fopen(optarg, "r");
+			if (!script)
+			{
+				perror(optarg);
+				return 1;
+			}
+			break;
+
+		case 't':
+			ticks = strtoul(optarg, NULL, 0);
+			break;
+
+		default:
+			firmware_file = NULL;
+			break;
+		}
+	}
+
+	if (!firmware_file || !symbol_file)
+	{
+		fprintf(stderr, "usage: %s -f game.out -y game.sym [-s script] [-t ticks]\n", argv[0]);
+		return 1;
+	}
+
+	if (!symbols_load(symbol_file))
+	{
+		fprintf(stderr, "no functions in symbol file\n");
+		return 1;
+	}
+
+	memset(&firmware, 0, sizeof(firmware));
+
+	if (elf_read_firmware(firmware_file, &firmware) != 0)
+	{
+		fprintf(stderr, "%s: can't load firmware\n", firmware_file);
+		return 1;
+	}
+
+	avr = avr_make_mcu_by_name(firmware.mmcu[0] ? firmware.mmcu : "atmega32u2");
+	if (!avr)
+	{
+		fprintf(stderr, "%s: unsupported mcu\n", firmware.mmcu);
+		return 1;
+	}
+
+	avr_init(avr);
+	avr->frequency = firmware.frequency ? firmware.frequency : F_CPU;
+	avr_load_firmware(avr, &firmware);
+
+	if (script && !script_load(script, avr->frequency))
+	{
+		fprintf(stderr, "bad input script\n");
+		return 1;
+	}
+
+	// Board stand-ins, every input released
+	for (index = 0; index < ARRAY_SIZE(INPUT_PIOS); index++)
+	{
+		input_set(avr, index, false);
+	}
+
+	for (index = 0; index < ARRAY_SIZE(watches); index++)
+	{
+		avr_irq_register_notify(pin_irq(avr, watches[index].pio), watch_notify, &watches[index]);
+	}
+
+	end = (uint64_t)ticks * avr->frequency / PROFILE_SCRIPT_RATE;
+
+	while ((avr->cycle < end) && (state != cpu_Done) && (state != cpu_Crashed))
+	{
+		ProfileSymbolStruct *symbol = (avr->state == cpu_Sleeping) ? &sleeping : symbol_find(avr->pc);
+		uint32_t            pc      = avr->pc;
+		uint64_t            start   = avr->cycle;
+		uint16_t            sp;
+
+		// Press scripted inputs that are due, release them after PROFILE_PRESS_TICKS
+		for (; (next < num_events) && (events[next].cycle <= start); next++)
+		{
+			input_set(avr, events[next].input, true);
+			released[events[next].input] = start + (uint64_t)PROFILE_PRESS_TICKS * avr->frequency / PROFILE_SCRIPT_RATE;
+		}
+
+		for (index = 0; index < ARRAY_SIZE(INPUT_PIOS); index++)
+		{
+			if (released[index] && (released[index] <= start))
+			{
+				input_set(avr, index, false);
+				released[index] = 0;
+			}
+		}
+
+		state           = avr_run(avr);
+		symbol->cycles += avr->cycle - start;
+		symbol->calls  += (symbol != &sleeping) && (pc == symbol->address);
+
+		sp     = avr->data[R_SPL] | (avr->data[R_SPH] << 8);
+		sp_min = (sp < sp_min) ? sp : sp_min;
+	}
+
+	if (state == cpu_Crashed)
+	{
+		fprintf(stderr, "firmware crashed at pc 0x%04x\n", avr->pc);
+	}
+
+	profile_print(avr, firmware_file, sp_min);
+	return state == cpu_Crashed;
+}
@@ -0,0 +1,507 @@
+/** @file   sim.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Batch simulation of seeded games
+ *          Plays many independent games on the host HAL and reports score and
+ *          lifetime distributions per gamemode for a sweep of difficulty settings
+ *
+ *  usage: sim [-n games] [-j workers] [-s seed] [-p idle|random|auto|<NESW. pattern>]
+ *             [-c curves] [-m max_hole_sizes]
+ *         curves and sizes are comma separated lists, eg. -c mode,linear,stepped -m 1,2,3
+ *         (curve "mode" is the gamemode's own speed curve)
+ *         policy "auto" is the demo's computer player (autoplay.h) moving on
+ *         every decision, how long a perfect player survives
+ *
+ *  A game still running after SIM_MAX_SECONDS or at SIM_MAX_SCORE (the score
+ *  is a uint8_t) is cut off and counted as censored: its score and lifetime
+ *  are lower bounds, so are the statistics of a mode with censored games.
+ *  Games end without the GAME OVER screen, see game_outro_enable().
+ *
+ *  Each game's walls get one of the 65535 states of the 16 bit wall PRNG, so a
+ *  fixed (idle, auto or script) policy accepts at most that many games per
+ *  mode. The random policy draws from its own 32 bit stream and may go past it.
+ *
+ *  Game modules keep their state in file-statics (one game per image), so
+ *  games are split across forked worker processes rather than threads.
+ *  Results are written to shared structure-of-arrays buffers.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "system.h"
+#include "task.h"
+#include "hal.h"
+#include "hal_host.h"
+#include "input.h"
+#include "character.h"
+#include "wall.h"
+#include "game_manager.h"
+#include "sound.h"
+#include "difficulty.h"
+#include "autoplay.h"
+
+#define SIM_INPUT_RATE        20        // Policy decisions per second
+#define SIM_MAX_SECONDS       3600      // Games still running after this are cut off
+#define SIM_MAX_SCORE         UINT8_MAX // Games reaching this score are cut off
+#define SIM_CHUNK_SIZE        256       // Games claimed by a worker at a time
+#define SIM_MAX_SWEEP         8         // Maximum values per swept setting
+#define SIM_LIFETIME_BUCKETS  (SIM_MAX_SECONDS + 1)
+#define SIM_CURVE_MODE        DIFFERENT_CURVES   // Use the gamemode's own curve
+#define SIM_WALL_SEEDS        65535     // Distinct wall PRNG states, see prng.h
+
+
+// Player input policy
+typedef enum
+{
+	POLICY_IDLE,
+	POLICY_RANDOM,
+	POLICY_AUTO,
+	POLICY_SCRIPT
+} SIM_POLICY_t;
+
+
+// Batch results, structure-of-arrays shared between workers
+typedef struct
+{
+	uint32_t count;          // Games in batch
+	uint32_t next;           // Next unclaimed game (atomic)
+	uint8_t  *score;         // Score per game
+	uint32_t *lifetime;      // Game length per game (virtual clock ticks)
+	bool     *censored;      // Game was cut off still running
+} SimBatchStruct;
+
+
+// State of the game a worker is currently playing
+typedef struct
+{
+	uint32_t   rng;               // Input policy generator, 32 bit xorshift state
+	uint16_t   script_index;      // Next character of POLICY_SCRIPT pattern
+} SimGameStruct;
+
+
+static const char *GAMEMODE_NAMES[DIFFERENT_GAMEMODES] =
+{
+	"HARD_MODE", "THREE_LIVES", "WALL_PUSH"
+};
+
+static const char *CURVE_NAMES[DIFFERENT_CURVES + 1] =
+{
+	"linear", "exponential", "stepped", "mode"
+};
+
+static SIM_POLICY_t  policy = POLICY_RANDOM;
+static const char    *script = "";
+static SimGameStruct game;
+
+
+/*  Mixes bits of a 32 bit value (murmur3 finaliser, a bijection)
+ *  @brief: spreads consecutive seeds and game indices over the whole range
+ */
+static uint32_t sim_mix(uint32_t x)
+{
+	x ^= x >> 16;
+	x *= 0x85EBCA6Bu;
+	x ^= x >> 13;
+	x *= 0xC2B2AE35u;
+	x ^= x >> 16;
+
+	return x;
+}
+
+
+/*  Returns a value in [0, bound) from the input policy stream
+ *  @param bound: number of possible values
+ */
+static uint8_t sim_rand_below(uint8_t bound)
+{
+	uint32_t x = game.rng;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	game.rng = x;
+	return (uint64_t)x * bound >> 32;
+}
+
+
+/*  Feed policy input to the HAL, sample it and update character
+ *  @param unused void pointer passed by task scheduler */
+static void input_task(__unused__ void *data)
+{
+	static const HAL_INPUT_t DIRECTIONS[] = { INPUT_NORTH, INPUT_EAST, INPUT_SOUTH, INPUT_WEST };
+	const char               *code;
+
+	switch (policy)
+	{
+	case POLICY_RANDOM:
+		if (sim_rand_below(2))                  // Move on half of the polls
+		{
+			hal_host_input_push(hal_host_now(), DIRECTIONS[sim_rand_below(ARRAY_SIZE(DIRECTIONS))]);
+		}
+		break;
+
+	case POLICY_SCRIPT:
+		if ((code = strchr("NESW", script[game.script_index])) != NULL)
+		{
+			hal_host_input_push(hal_host_now(), DIRECTIONS[code - "NESW"]);
+		}
+		game.script_index = (script[game.script_index + 1] != '\0') ? game.script_index + 1 : 0;
+		break;
+
+	case POLICY_AUTO:                           // Presses are replaced by autoplay_update()
+	case POLICY_IDLE:
+	default:
+		break;
+	}
+
+	input_sample();
+	input_update();
+	autoplay_update();
+	character_update();
+}
+
+
+/*  Same as wall_task in game.c, stops the run once the game ends or reaches SIM_MAX_SCORE
+ *  @param unused void pointer passed by task scheduler */
+static void wall_task(__unused__ void *data)
+{
+	if (!difficulty_tick())
+	{
+		return;
+	}
+
+	if (move_walls())
+	{
+		toggle_stun(0);
+	}
+
+	if (wall_spawn_due())
+	{
+		wall_create(wall_count() ? WALL_CROSSING_PERIOD : WALL_FULL_SPEED);
+		increment_score();
+	}
+
+	if (wall_impact_p())
+	{
+		check_collisions();
+	}
+
+	if (!get_game_state() || (get_score() == SIM_MAX_SCORE))
+	{
+		hal_host_stop();
+	}
+}
+
+
+/*  Plays one game to completion
+ *  @param base_seed: seed of the whole run
+ *  @param game_index: game number within its mode, below SIM_WALL_SEEDS
+ *         gives each game different walls
+ *  @param mode: gamemode to play
+ *  @param curve: wall speed curve, SIM_CURVE_MODE for the gamemode's own
+ *  @param batch, index: results are stored at index in batch
+ */
+static void sim_game(uint32_t base_seed, uint32_t game_index, GAMEMODES_t mode, uint8_t curve, SimBatchStruct *batch, uint32_t index)
+{
+	task_t tasks[] =
+	{
+		{ .func = input_task,      .period = TASK_RATE / SIM_INPUT_RATE       },
+		{ .func = wall_task,       .period = TASK_RATE / DIFFICULTY_TICK_RATE },
+	};
+	uint16_t wall_seed = 1 + (sim_mix(base_seed) + (uint64_t)game_index) % SIM_WALL_SEEDS;   // Never 0
+
+	game = (SimGameStruct){
+		.rng          = sim_mix(base_seed ^ sim_mix(game_index + 1)),
+		.script_index = 0
+	};
+	game.rng = game.rng ? game.rng : 1;           // xorshift can't leave 0
+
+	hal_host_reset();
+	game_mode_set(mode);
+
+	if (policy == POLICY_AUTO)
+	{
+		autoplay_start(1);
+	}
+
+	game_start();
+	wall_rand_state_set(wall_seed);               // Seed walls directly rather than from wall_random_seed
+
+	if (curve != SIM_CURVE_MODE)
+	{
+		difficulty_start(curve);
+	}
+
+	hal_run(tasks, ARRAY_SIZE(tasks));
+	autoplay_stop();
+
+	batch->score[index]    = get_score();
+	batch->lifetime[index] = hal_host_now();
+	batch->censored[index] = get_game_state();
+
+	if (batch->censored[index])
+	{
+		game_stop();
+	}
+}
+
+
+/*  Worker process, claims chunks of games until the batch is done
+ */
+static void sim_worker(SimBatchStruct *batch, uint32_t base_seed, uint8_t curve, uint8_t hole_size)
+{
+	uint32_t start;
+
+	sound_init();
+	game_outro_enable(false);
+	wall_max_hole_size_set(hole_size);
+	hal_host_run_limit_set(SIM_MAX_SECONDS * (uint32_t)TASK_RATE);
+
+	while ((start = __atomic_fetch_add(&batch->next, SIM_CHUNK_SIZE, __ATOMIC_RELAXED)) < batch->count)
+	{
+		uint32_t end = (start + SIM_CHUNK_SIZE < batch->count) ? start + SIM_CHUNK_SIZE : batch->count;
+		uint32_t index;
+
+		for (index = start; index < end; index++)
+		{
+			sim_game(base_seed, index / DIFFERENT_GAMEMODES, index % DIFFERENT_GAMEMODES, curve, batch, index);
+		}
+	}
+}
+
+
+/*  Prints score/lifetime distribution of one gamemode
+ *  @brief: games of mode m are at indices m, m + DIFFERENT_GAMEMODES, ...
+ */
+static void sim_report(const SimBatchStruct *batch, uint8_t curve, uint8_t hole_size, GAMEMODES_t mode)
+{
+	static uint32_t score_histogram[256];
+	static uint32_t lifetime_histogram[SIM_LIFETIME_BUCKETS];
+	uint32_t        games         = 0;
+	uint32_t        censored      = 0;
+	double          score_sum     = 0;
+	double          lifetime_sum  = 0;
+	uint8_t         score_max     = 0;
+	uint32_t        score_p50     = 0, score_p90 = 0, life_p50 = 0, life_p90 = 0;
+	uint32_t        seen, index;
+
+	memset(score_histogram, 0, sizeof(score_histogram));
+	memset(lifetime_histogram, 0, sizeof(lifetime_histogram));
+
+	for (index = mode; index < batch->count; index += DIFFERENT_GAMEMODES)
+	{
+		uint32_t seconds = batch->lifetime[index] / TASK_RATE;
+
+		score_histogram[batch->score[index]]++;
+		lifetime_histogram[seconds < SIM_LIFETIME_BUCKETS ? seconds : SIM_LIFETIME_BUCKETS - 1]++;
+		score_sum    += batch->score[index];
+		lifetime_sum += (double)batch->lifetime[index] / TASK_RATE;
+		score_max     = (batch->score[index] > score_max) ? batch->score[index] : score_max;
+		censored     += batch->censored[index];
+		games++;
+	}
+
+	if (games == 0)
+	{
+		return;
+	}
+
+	for (index = 0, seen = 0; index < 256; index++)
+	{
+		seen     += score_histogram[index];
+		score_p50 = (seen * 2 < games) ? index + 1 : score_p50;
+		score_p90 = (seen * 10 < games * 9) ? index + 1 : score_p90;
+	}
+
+	for (index = 0, seen = 0; index < SIM_LIFETIME_BUCKETS; index++)
+	{
+		seen    += lifetime_histogram[index];
+		life_p50 = (seen * 2 < games) ? index + 1 : life_p50;
+		life_p90 = (seen * 10 < games * 9) ? index + 1 : life_p90;
+	}
+
+	printf("%s\t%u\t%s\t%lu\t%lu\t%.2f\t%lu\t%lu\t%u\t%.1f\t%lu\t%lu\n",
+	       CURVE_NAMES[curve], hole_size, GAMEMODE_NAMES[mode], (unsigned long)games, (unsigned long)censored,
+	       score_sum / games, (unsigned long)score_p50, (unsigned long)score_p90, score_max,
+	       lifetime_sum / games, (unsigned long)life_p50, (unsigned long)life_p90);
+}
+
+
+/*  Parses comma separated list of curve names
+ *  @return number of values parsed, 0 on unknown name
+ */
+static uint8_t sim_curves_parse(const char *text, uint8_t *values)
+{
+	uint8_t count = 0;
+
+	while (count < SIM_MAX_SWEEP)
+	{
+		size_t  length = strcspn(text, ",");
+		uint8_t curve;
+
+		for (curve = 0; (curve <= DIFFERENT_CURVES) &&
+		     ((strlen(CURVE_NAMES[curve]) != length) || strncmp(text, CURVE_NAMES[curve], length)); curve++)
+		{
+		}
+
+		if (curve > DIFFERENT_CURVES)
+		{
+			return 0;
+		}
+		values[count++] = curve;
+
+		if (text[length] != ',')
+		{
+			break;
+		}
+		text += length + 1;
+	}
+
+	return count;
+}
+
+
+/*  Parses comma separated list of small integers
+ *  @return number of values parsed
+ */
+static uint8_t sim_list_parse(const char *text, uint8_t *values)
+{
+	uint8_t count = 0;
+	char    *end;
+
+	while (count < SIM_MAX_SWEEP)
+	{
+		values[count++] = strtoul(text, &end, 10);
+
+		if (*end != ',')
+		{
+			break;
+		}
+		text = end + 1;
+	}
+
+	return count;
+}
+
+
+int main(int argc, char **argv)
+{
+	uint32_t       games_per_mode        = 10000;
+	uint32_t       base_seed             = 1;
+	long           workers               = sysconf(_SC_NPROCESSORS_ONLN);
+	uint8_t        curves[SIM_MAX_SWEEP] = { SIM_CURVE_MODE };
+	uint8_t        holes[SIM_MAX_SWEEP]  = { MAX_HOLE_SIZE };
+	uint8_t        num_curves            = 1, num_holes = 1;
+	uint8_t        curve, hole;
+	SimBatchStruct *batch;
+	int            option;
+
+	while ((option = getopt(argc, argv, "n:j:s:p:c:m:")) != -1)
+	{
+		switch (option)
+		{
+		case 'n':
+			games_per_mode = strtoul(optarg, NULL, 0);
+			break;
+
+		case 'j':
+			workers = strtol(optarg, NULL, 0);
+			break;
+
+		case 's':
+			base_seed = strtoul(optarg, NULL, 0);
+			break;
+
+		case 'p':
+			policy = (strcmp(optarg, "idle") == 0) ? POLICY_IDLE : (strcmp(optarg, "random") == 0) ? POLICY_RANDOM :
+			         (strcmp(optarg, "auto") == 0) ? POLICY_AUTO : POLICY_SCRIPT;
+			script = optarg;
+			break;
+
+		case 'c':
+			num_curves = sim_curves_parse(optarg, curves);
+			break;
+
+		case 'm':
+			num_holes = sim_list_parse(optarg, holes);
+			break;
+
+		default:
+			fprintf(stderr, "usage: %s [-n games] [-j workers] [-s seed] [-p idle|random|auto|<NESW. pattern>] "
+			        "[-c curves] [-m max_hole_sizes]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if ((workers < 1) || (games_per_mode == 0) || (num_curves == 0) || (num_holes == 0) ||
+	    ((policy == POLICY_SCRIPT) && (script[0] == '\0')))
+	{
+		fprintf(stderr, "bad arguments\n");
+		return 1;
+	}
+
+	if ((policy != POLICY_RANDOM) && (games_per_mode > SIM_WALL_SEEDS))
+	{
+		fprintf(stderr, "-n above %u replays identical games with a fixed input policy\n", SIM_WALL_SEEDS);
+		return 1;
+	}
+
+	// Batch header and result arrays live in memory shared with the workers
+	batch = mmap(NULL, sizeof(SimBatchStruct), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	if (batch == MAP_FAILED)
+	{
+		perror("mmap");
+		return 1;
+	}
+
+	batch->count    = games_per_mode * DIFFERENT_GAMEMODES;
+	batch->score    = mmap(NULL, batch->count * sizeof(uint8_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	batch->lifetime = mmap(NULL, batch->count * sizeof(uint32_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	batch->censored = mmap(NULL, batch->count * sizeof(bool), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+	if ((batch->score == MAP_FAILED) || (batch->lifetime == MAP_FAILED) || (batch->censored == MAP_FAILED))
+	{
+		perror("mmap");
+		return 1;
+	}
+
+	printf("# curve\thole\tmode\tgames\tcensored\tscore_mean\tscore_p50\tscore_p90\tscore_max\tlife_mean_s\tlife_p50_s\tlife_p90_s\n");
+
+	for (curve = 0; curve < num_curves; curve++)
+	{
+		for (hole = 0; hole < num_holes; hole++)
+		{
+			long        worker;
+			GAMEMODES_t mode;
+
+			batch->next = 0;
+			fflush(stdout);
+
+			for (worker = 0; worker < workers; worker++)
+			{
+				if (fork() == 0)
+				{
+					sim_worker(batch, base_seed, curves[curve], holes[hole]);
+					_exit(0);
+				}
+			}
+
+			while (wait(NULL) > 0)
+			{
+			}
+
+			for (mode = HARD_MODE; mode < DIFFERENT_GAMEMODES; mode++)
+			{
+				sim_report(batch, curves[curve], holes[hole], mode);
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,23 @@
+/** @file   system.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Host stand-in for drivers/avr/system.h
+ *          Only the definitions used by the game modules
+ */
+
+#ifndef SYSTEM_H
+#define SYSTEM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BIT(X)                (1 << (X))
+#define ARRAY_SIZE(ARRAY)     (sizeof(ARRAY) / sizeof(ARRAY[0]))
+#define __unused__            __attribute__((unused))
+
+// UCFK4 LED matrix dimensions
+#define LEDMAT_ROWS_NUM       7
+#define LEDMAT_COLS_NUM       5
+
+
+#endif
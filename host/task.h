@@ -0,0 +1,32 @@
+/** @file   task.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Host stand-in for utils/task.h
+ *          Tasks are run by the virtual clock in hal_host.c (see hal_run())
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include "system.h"
+
+// Virtual clock ticks per second
+#define TASK_RATE    10000
+
+
+typedef uint16_t task_tick_t;
+
+typedef void (*task_func_t)(void *data);
+
+
+// Same layout as the UCFK4 task table entry
+typedef struct task_struct
+{
+	task_func_t func;                // Function to call
+	void        *data;               // Argument passed to func
+	task_tick_t period;              // Ticks between calls
+	task_tick_t reschedule;          // Tick of next call
+} task_t;
+
+
+#endif
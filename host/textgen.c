@@ -0,0 +1,156 @@
+/** @file   textgen.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Build-time generator for text_table.h
+ *          Renders every fixed message (MESSAGE_t, strings from game_manager.h)
+ *          and the digits 0-9 through font3x5_1 into scroll lines, one byte per
+ *          font column with bit n lighting display column n (same layout as
+ *          tinygl's rotated text). Each character is SCROLL_GLYPH_LINES lines,
+ *          the font columns followed by blank lines.
+ *
+ *  usage: textgen > text_table.h
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "system.h"
+#include "font.h"
+#include "../../../fonts/font3x5_1.h"
+#include "scroll.h"
+#include "game_manager.h"
+
+#define LINES_PER_ROW    16
+
+
+// Source string of each message
+static const char *MESSAGES[NUM_MESSAGES] =
+{
+	[MESSAGE_GAME_MODE_PROMPT] = GAME_MODE_PROMPT,
+	[MESSAGE_HARD_MODE]        = HARD_MODE_TEXT,
+	[MESSAGE_THREE_LIVES]      = THREE_LIVES_TEXT,
+	[MESSAGE_WALL_PUSH]        = WALL_PUSH_TEXT,
+	[MESSAGE_END_PROMPT]       = END_PROMPT,
+	[MESSAGE_BEST_PROMPT]      = BEST_PROMPT
+};
+
+
+/*  Returns scroll line of a character
+ *  @param line: 0..SCROLL_GLYPH_LINES-1, lines past the font width are blank
+ */
+static uint8_t glyph_line(char ch, uint8_t line)
+{
+	uint8_t x, bits = 0;
+
+	if (line >= font3x5_1.width)
+	{
+		return 0;
+	}
+
+	for (x = 0; x < font3x5_1.height; x++)
+	{
+		bits |= font_pixel_get(&font3x5_1, ch, line, font3x5_1.height - 1 - x) << x;
+	}
+
+	return bits;
+}
+
+
+/*  Prints a message as a C string literal
+ */
+static void string_print(const char *string)
+{
+	putchar('"');
+
+	for (; *string; string++)
+	{
+		if ((*string == '"') || (*string == '\\'))
+		{
+			putchar('\\');
+		}
+		putchar(*string);
+	}
+
+	putchar('"');
+}
+
+
+int main(void)
+{
+	unsigned int message, line, count = 0;
+	const char   *ch;
+
+	if ((font3x5_1.width > SCROLL_GLYPH_LINES) || (font3x5_1.height > 8))
+	{
+		fprintf(stderr, "textgen: font does not fit scroll lines\n");
+		return 1;
+	}
+
+	printf("/* Generated by textgen, do not edit (strings are in game_manager.h) */\n\n");
+
+	printf("// Lines of every message, in MESSAGE_t order\n");
+	printf("static const uint8_t TEXT_LINES[] PROGMEM =\n{");
+
+	for (message = 0; message < NUM_MESSAGES; message++)
+	{
+		printf("\n\t// ");
+		string_print(MESSAGES[message]);
+		printf("\n");
+
+		for (ch = MESSAGES[message]; *ch; ch++)
+		{
+			for (line = 0; line < SCROLL_GLYPH_LINES; line++, count++)
+			{
+				printf("%s0x%02X,%s", (count % LINES_PER_ROW) ? "" : "\t", glyph_line(*ch, line),
+				       ((count + 1) % LINES_PER_ROW) ? " " : "\n");
+			}
+		}
+
+		printf("%s", (count % LINES_PER_ROW) ? "\n" : "");
+		count = 0;
+	}
+
+	printf("};\n\n");
+
+	printf("// TEXT_LINES index of the first line of each message, then the end\n");
+	printf("static const uint16_t TEXT_STARTS[NUM_MESSAGES + 1] PROGMEM =\n{\n\t");
+
+	for (message = 0, line = 0; message <= NUM_MESSAGES; message++)
+	{
+		printf("%u%s", line, (message < NUM_MESSAGES) ? ", " : "\n");
+		line += (message < NUM_MESSAGES) ? strlen(MESSAGES[message]) * SCROLL_GLYPH_LINES : 0;
+	}
+
+	printf("};\n\n");
+
+	printf("// Lines of the digits, for the scores\n");
+	printf("static const uint8_t TEXT_DIGIT_LINES[10][SCROLL_GLYPH_LINES] PROGMEM =\n{\n");
+
+	for (message = 0; message < 10; message++)
+	{
+		printf("\t{");
+
+		for (line = 0; line < SCROLL_GLYPH_LINES; line++)
+		{
+			printf(" 0x%02X%s", glyph_line('0' + message, line), (line + 1 < SCROLL_GLYPH_LINES) ? "," : " ");
+		}
+
+		printf("},\n");
+	}
+
+	printf("};\n\n");
+
+	printf("#ifndef __AVR__\n");
+	printf("// Source strings, for printing on the host\n");
+	printf("static const char *const TEXT_STRINGS[NUM_MESSAGES] =\n{\n");
+
+	for (message = 0; message < NUM_MESSAGES; message++)
+	{
+		printf("\t");
+		string_print(MESSAGES[message]);
+		printf(",\n");
+	}
+
+	printf("};\n");
+	printf("#endif\n");
+	return 0;
+}
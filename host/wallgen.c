@@ -0,0 +1,297 @@
+/** @file   wallgen.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Build-time generator for wall_table.h
+ *          Lists every legal wall (direction x hole size x hole shift, using the
+ *          wall.h initialisers) sorted by hole size, and for each gamemode a
+ *          table of WALL_WEIGHT_SLOTS wall indices where each wall appears in
+ *          proportion to its weight. wall_create() then needs one random byte.
+ *          For every wall and every player cell across its path, the shortest
+ *          move sequence to a hole cell is tabled for wall_escape().
+ *
+ *  usage: wallgen > wall_table.h
+ *
+ *  Weights are set in MODE_WEIGHTS below, reshaping difficulty only needs
+ *  this table changed and the firmware rebuilt. Every mode must give walls
+ *  with a hole of 1 some slots (wall_max_hole_size_set(1)), else the build fails.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "wall.h"
+#include "game_manager.h"
+
+#define WALL_WEIGHT_SLOTS    256      // Slots per gamemode, one random byte picks one
+#define MAX_WALLS            64
+#define WALLS_PER_LINE       4
+#define SLOTS_PER_LINE       16
+#define ESCAPE_CELLS         ((ROW_SIZE > COLUMN_SIZE) ? ROW_SIZE : COLUMN_SIZE)
+
+
+// Relative weight of a wall's direction and hole size per gamemode,
+// hole positions of the same size are equally likely
+typedef struct
+{
+	const char *name;
+	double     direction[NUM_OF_DIRECTIONS + 1];    // Indexed by WALL_DIRECTION_t
+	double     hole_size[MAX_HOLE_SIZE + 1];        // Indexed by hole size
+} ModeWeightsStruct;
+
+
+static const ModeWeightsStruct MODE_WEIGHTS[DIFFERENT_GAMEMODES] =
+{
+	[HARD_MODE]   = { "HARD_MODE",   { 0, 1, 1, 1, 1 }, { 0, 3, 2, 1 } },   // Favour small holes
+	[THREE_LIVES] = { "THREE_LIVES", { 0, 1, 1, 1, 1 }, { 0, 1, 1, 1 } },   // Same as wall_create() before the table
+	[WALL_PUSH]   = { "WALL_PUSH",   { 0, 1, 1, 1, 1 }, { 0, 1, 1, 1 } }
+};
+
+static const char *DIRECTION_NAMES[] = { "", "NORTH", "SOUTH", "WEST", "EAST" };
+static const char *TYPE_NAMES[]      = { "COLUMN", "ROW", "OUT_OF_BOUNDS" };
+
+
+// Legal wall and the values it was made from
+typedef struct
+{
+	WallStruct       wall;
+	WALL_DIRECTION_t direction;
+	uint8_t          hole_size;
+	uint8_t          shifts;          // Number of legal hole shifts for this direction and size
+} WallEntryStruct;
+
+
+static WallEntryStruct walls[MAX_WALLS];
+static uint8_t         num_walls = 0;
+
+
+/*  Adds every legal wall with the given hole size, same rules as wall_create() had
+ */
+static void walls_add(uint8_t hole_size)
+{
+	WALL_DIRECTION_t direction;
+	uint8_t          shift;
+
+	for (direction = NORTH; direction <= EAST; direction++)
+	{
+		uint8_t wall_size = ((direction == NORTH || direction == SOUTH) ? ROW_SIZE : COLUMN_SIZE) + 1;
+		uint8_t shifts    = wall_size - hole_size;
+
+		for (shift = 0; shift < shifts; shift++)
+		{
+			uint8_t    bitmap = GENERATE_HOLE((BIT(hole_size) - 1), shift);
+			WallStruct wall;
+
+			switch (direction)
+			{
+			case NORTH:
+				wall = (WallStruct)NORTH_MOVING_WALL(bitmap);
+				break;
+
+			case SOUTH:
+				wall = (WallStruct)SOUTH_MOVING_WALL(bitmap);
+				break;
+
+			case WEST:
+				wall = (WallStruct)WEST_MOVING_WALL(bitmap);
+				break;
+
+			case EAST:
+			default:
+				wall = (WallStruct)EAST_MOVING_WALL(bitmap);
+				break;
+			}
+
+			walls[num_walls++] = (WallEntryStruct){
+				.wall = wall, .direction = direction, .hole_size = hole_size, .shifts = shifts
+			};
+		}
+	}
+}
+
+
+/*  Prints weight table of one gamemode
+ *  @brief: Slots are shared out by largest remainder so they always total WALL_WEIGHT_SLOTS
+ *  @return false if some max hole size leaves no slot to pick (wall_create() would never return)
+ */
+static bool weights_print(const ModeWeightsStruct *mode)
+{
+	double  share[MAX_WALLS];
+	int     slots[MAX_WALLS];
+	double  direction_total = 0, hole_total = 0;
+	int     used            = 0;
+	uint8_t index, size, slot = 0;
+
+	for (index = NORTH; index <= EAST; index++)
+	{
+		direction_total += mode->direction[index];
+	}
+
+	for (size = 1; size <= MAX_HOLE_SIZE; size++)
+	{
+		hole_total += mode->hole_size[size];
+	}
+
+	for (index = 0; index < num_walls; index++)
+	{
+		share[index] = WALL_WEIGHT_SLOTS * (mode->direction[walls[index].direction] / direction_total) *
+		               (mode->hole_size[walls[index].hole_size] / hole_total) / walls[index].shifts;
+		slots[index] = (int)share[index];
+		used        += slots[index];
+	}
+
+	while (used < WALL_WEIGHT_SLOTS)
+	{
+		uint8_t best = 0;
+
+		for (index = 1; index < num_walls; index++)
+		{
+			best = (share[index] - slots[index] > share[best] - slots[best]) ? index : best;
+		}
+		slots[best]++;
+		used++;
+	}
+
+	printf("\t[%s] =\n\t{\n", mode->name);
+
+	for (index = 0; index < num_walls; index++)
+	{
+		int count;
+
+		for (count = 0; count < slots[index]; count++, slot++)
+		{
+			printf("%s%2u,%s", (slot % SLOTS_PER_LINE) ? "" : "\t\t", index,
+			       ((slot + 1) % SLOTS_PER_LINE) ? " " : "\n");
+		}
+	}
+
+	printf("\t},\n");
+
+	// wall_max_hole_size_set() can limit walls to any hole size prefix
+	for (size = 1; size <= MAX_HOLE_SIZE; size++)
+	{
+		for (index = 0; (index < num_walls) && ((walls[index].hole_size > size) || (slots[index] == 0)); index++)
+		{
+		}
+
+		if (index == num_walls)
+		{
+			fprintf(stderr, "wallgen: %s has no wall with a hole of %u or less\n", mode->name, size);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/*  Prints escape table row of one wall
+ *  @brief: a cell's way out is the nearest hole cell along the wall, ties go to
+ *          the one nearer the middle (further from the next wall's edge).
+ *          The position along the path doesn't change it, so it isn't an index.
+ *          Cells past the end of a ROW wall are padding
+ */
+static void escape_print(const WallEntryStruct *entry)
+{
+	const WallStruct *wall = &entry->wall;
+	uint8_t          span  = (wall->wall_type == ROW) ? ROW_SIZE : COLUMN_SIZE;
+	uint8_t          cell, hole;
+
+	printf("\t{");
+
+	for (cell = 0; cell < ESCAPE_CELLS; cell++)
+	{
+		int     best   = -1;
+		uint8_t escape = WALL_ESCAPE_STAY;
+
+		for (hole = 0; (cell < span) && (hole < span); hole++)
+		{
+			if (wall->bit_data & BIT(hole))
+			{
+				continue;
+			}
+
+			if ((best < 0) || (abs(hole - cell) < abs(best - cell)) ||
+			    ((abs(hole - cell) == abs(best - cell)) && (abs(2 * hole - (span - 1)) < abs(2 * best - (span - 1)))))
+			{
+				best = hole;
+			}
+		}
+
+		if ((best >= 0) && (best != cell))
+		{
+			WALL_DIRECTION_t direction = (wall->wall_type == ROW) ? ((best > cell) ? EAST : WEST) :
+			                                                        ((best > cell) ? SOUTH : NORTH);
+			escape = WALL_ESCAPE(direction, abs(best - cell));
+		}
+
+		printf("%s 0x%02X", cell ? "," : "", escape);
+	}
+
+	printf(" },    // %s 0x%02X\n", DIRECTION_NAMES[wall->direction], wall->bit_data);
+}
+
+
+int main(void)
+{
+	uint8_t index, size;
+
+	for (size = 1; size <= MAX_HOLE_SIZE; size++)
+	{
+		walls_add(size);
+	}
+
+	printf("/* Generated by wallgen, do not edit (weights are in host/wallgen.c) */\n\n");
+	printf("#define WALL_TABLE_SIZE      %u\n", num_walls);
+	printf("#define WALL_WEIGHT_SLOTS    %u\n\n", WALL_WEIGHT_SLOTS);
+
+	printf("// Every legal wall, sorted by hole size\n");
+	printf("static const WallStruct WALL_TABLE[WALL_TABLE_SIZE] PROGMEM =\n{\n");
+
+	for (index = 0; index < num_walls; index++)
+	{
+		const WallStruct *wall = &walls[index].wall;
+
+		printf("%s{ 0x%02X, %u, %u, %s, %s },%s", (index % WALLS_PER_LINE) ? "" : "\t",
+		       wall->bit_data, wall->pos, wall->boundary_cond, TYPE_NAMES[wall->wall_type],
+		       DIRECTION_NAMES[wall->direction], ((index + 1) % WALLS_PER_LINE) ? " " : "\n");
+	}
+
+	printf("%s};\n\n", (num_walls % WALLS_PER_LINE) ? "\n" : "");
+
+	printf("// WALL_TABLE indices past the last wall with each hole size\n");
+	printf("static const uint8_t WALL_TABLE_HOLE_END[MAX_HOLE_SIZE + 1] PROGMEM =\n{\n\t0,");
+
+	for (size = 1; size <= MAX_HOLE_SIZE; size++)
+	{
+		for (index = 0; (index < num_walls) && (walls[index].hole_size <= size); index++)
+		{
+		}
+		printf(" %u,", index);
+	}
+
+	printf("\n};\n\n");
+
+	printf("// WALL_TABLE index of each slot, per gamemode\n");
+	printf("static const uint8_t WALL_WEIGHTS[DIFFERENT_GAMEMODES][WALL_WEIGHT_SLOTS] PROGMEM =\n{\n");
+
+	for (index = 0; index < DIFFERENT_GAMEMODES; index++)
+	{
+		if (!weights_print(&MODE_WEIGHTS[index]))
+		{
+			return 1;
+		}
+	}
+
+	printf("};\n\n");
+
+	printf("// Way out of each wall's path (WALL_ESCAPE()) per WALL_TABLE index and cell across the path\n");
+	printf("static const uint8_t ESCAPE_TABLE[WALL_TABLE_SIZE][%u] PROGMEM =\n{\n", ESCAPE_CELLS);
+
+	for (index = 0; index < num_walls; index++)
+	{
+		escape_print(&walls[index]);
+	}
+
+	printf("};\n");
+	return 0;
+}
@@ -0,0 +1,139 @@
+/** @file   input.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Shared input stage
+ */
+
+#include "system.h"
+#include "input.h"
+#include "hal.h"
+
+#define INPUT_QUEUE_MASK    (INPUT_QUEUE_SIZE - 1)
+
+
+/* Single-producer/single-consumer ring
+ * head is only written by the producer, tail only by the consumer,
+ * so neither side needs interrupts disabled
+ */
+typedef struct
+{
+	uint8_t          inputs[INPUT_QUEUE_SIZE];   // HAL_INPUT_t of each press
+	volatile uint8_t head;            // Next slot to write
+	volatile uint8_t tail;            // Next slot to read
+} InputQueueStruct;
+
+
+static InputQueueStruct    queue;
+static InputSnapshotStruct snapshot;
+
+
+/*  Producer side: append press unless queue is full
+ */
+static void queue_push(HAL_INPUT_t input)
+{
+	uint8_t head = queue.head;
+
+	if (((head + 1) & INPUT_QUEUE_MASK) == queue.tail)
+	{
+		return;
+	}
+
+	queue.inputs[head] = input;
+	queue.head         = (head + 1) & INPUT_QUEUE_MASK;       // Publish after the press is written
+}
+
+
+/*  Consumer side: pop oldest press
+ */
+static bool queue_pop(uint8_t *input)
+{
+	uint8_t tail = queue.tail;
+
+	if (tail == queue.head)
+	{
+		return false;
+	}
+
+	*input     = queue.inputs[tail];
+	queue.tail = (tail + 1) & INPUT_QUEUE_MASK;       // Release slot after the press is read
+	return true;
+}
+
+
+/*  Drop queued presses and clear the snapshot
+ *  @brief: Consumer side, drops everything the producer has published
+ */
+void input_flush(void)
+{
+	queue.tail       = queue.head;
+	snapshot.presses = 0;
+}
+
+
+/*  Sample navswitch and button, queue new presses
+ *  @brief: Presses are dropped if the queue is full
+ */
+void input_sample(void)
+{
+	uint8_t input;
+
+	hal_navswitch_update();
+	hal_button_update();
+
+	for (input = INPUT_NORTH; input <= INPUT_PUSH; input++)
+	{
+		if (hal_navswitch_push_event_p(input))
+		{
+			queue_push(input);
+		}
+	}
+
+	if (hal_button_push_event_p())
+	{
+		queue_push(INPUT_BUTTON);
+	}
+}
+
+
+/*  Publish snapshot of presses queued since the last call
+ *  @brief: Call once per game tick, before any module reads input.
+ *          Every queued press is latched, repeats of an input within a tick count once
+ */
+void input_update(void)
+{
+	uint8_t input;
+
+	snapshot.time    = hal_clock();
+	snapshot.presses = 0;
+
+	while (queue_pop(&input))
+	{
+		snapshot.presses |= BIT(input);
+	}
+}
+
+
+/*  Returns current snapshot
+ */
+const InputSnapshotStruct *input_snapshot(void)
+{
+	return &snapshot;
+}
+
+
+/*  Replace presses of the current snapshot
+ *  @param presses: BIT(HAL_INPUT_t) of every input pressed
+ */
+void input_presses_set(uint8_t presses)
+{
+	snapshot.presses = presses;
+}
+
+
+/*  Returns true if input was pressed in the current snapshot
+ *  @param input: navswitch direction/push or button
+ */
+bool input_pressed_p(HAL_INPUT_t input)
+{
+	return (snapshot.presses & BIT(input)) != 0;
+}
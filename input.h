@@ -0,0 +1,70 @@
+/** @file   input.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Shared input stage
+ *          input_sample() is the only reader of the navswitch and button.
+ *          It runs at INPUT_SAMPLE_RATE so taps between game ticks are kept,
+ *          and pushes each debounced press into a single-producer/single-consumer
+ *          ring. Once per game tick input_update() latches the ring into a
+ *          snapshot of the inputs pressed since the last tick (a bitmask, the
+ *          order of presses within a tick is not kept), which every module reads
+ *          with input_pressed_p() without consuming it. The ring is lock-free,
+ *          so input_sample() can be moved into an interrupt without changing
+ *          the consumers.
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "system.h"
+#include "task.h"
+#include "hal.h"
+
+#define INPUT_SAMPLE_RATE      200                      // Rate input_sample() is called in hz
+#define INPUT_QUEUE_SIZE       16                       // Presses buffered between ticks, power of 2
+
+
+// Presses of one game tick
+typedef struct
+{
+	task_tick_t time;          // hal_clock() when published
+	uint8_t     presses;       // BIT(HAL_INPUT_t) of every input pressed
+} InputSnapshotStruct;
+
+
+/*  Drop queued presses and clear the snapshot
+ */
+void input_flush(void);
+
+
+/*  Sample navswitch and button, queue new presses
+ *  @brief: Presses are dropped if the queue is full
+ */
+void input_sample(void);
+
+
+/*  Publish snapshot of presses queued since the last call
+ *  @brief: Call once per game tick, before any module reads input
+ */
+void input_update(void);
+
+
+/*  Returns current snapshot
+ */
+const InputSnapshotStruct *input_snapshot(void);
+
+
+/*  Replace presses of the current snapshot
+ *  @param presses: BIT(HAL_INPUT_t) of every input pressed
+ *  @brief: Used by replay playback, call after input_update()
+ */
+void input_presses_set(uint8_t presses);
+
+
+/*  Returns true if input was pressed in the current snapshot
+ *  @param input: navswitch direction/push or button
+ */
+bool input_pressed_p(HAL_INPUT_t input);
+
+
+#endif
@@ -0,0 +1,45 @@
+/** @file   mixer.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Two voice square wave mixer for the 1 bit piezo output
+ */
+
+#include "system.h"
+#include "mixer.h"
+#include <avr/pgmspace.h>
+
+#define MIXER_OCTAVE        8                   // Octave of MIXER_STEPS (C7..B7)
+#define MIXER_NOTE_MAX      (MIXER_OCTAVE * 12 + 11)
+#define MIXER_STEP(FREQ)    ((uint16_t)((FREQ) * 65536.0 / MIXER_SAMPLE_RATE + 0.5))
+
+// Phase steps of MIDI notes 96..107 (highest below half the sample rate), lower octaves are shifted
+static const uint16_t MIXER_STEPS[] PROGMEM =
+{
+	MIXER_STEP(2093.00), MIXER_STEP(2217.46), MIXER_STEP(2349.32),
+	MIXER_STEP(2489.02), MIXER_STEP(2637.02), MIXER_STEP(2793.83),
+	MIXER_STEP(2959.96), MIXER_STEP(3135.96), MIXER_STEP(3322.44),
+	MIXER_STEP(3520.00), MIXER_STEP(3729.31), MIXER_STEP(3951.07)
+};
+
+
+/*  Silence every voice
+ *  @param mixer: mixer
+ */
+void mixer_init(MixerStruct *mixer)
+{
+	*mixer = (MixerStruct){ .error = 0 };
+}
+
+
+/*  Returns phase step of a note
+ *  @param note: MIDI note number, 0 (and notes above MIXER_NOTE_MAX) for silence
+ */
+uint16_t mixer_note_step(uint8_t note)
+{
+	if ((note == 0) || (note > MIXER_NOTE_MAX))
+	{
+		return 0;
+	}
+
+	return pgm_read_word(&MIXER_STEPS[note % 12]) >> (MIXER_OCTAVE - note / 12);
+}
@@ -0,0 +1,89 @@
+/** @file   mixer.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Two voice square wave mixer for the 1 bit piezo output
+ *          Each voice is a 16 bit phase accumulator, its square wave is the
+ *          top bit of the phase. While both voices sound, their sum is turned
+ *          back into one bit by a first order sigma-delta modulator, so a
+ *          sample costs two adds and a compare. hal.c runs it from the
+ *          Timer0 interrupt while both voices sound (a single voice is a
+ *          plain half period toggle there), host/hal_host.c renders it to PCM.
+ */
+
+#ifndef MIXER_H
+#define MIXER_H
+
+#include "system.h"
+
+#define MIXER_VOICES         2
+#define MIXER_SAMPLE_RATE    8000           // Samples per second
+
+
+// Output of one sample
+typedef enum
+{
+	MIXER_OFF,                              // No voice sounding
+	MIXER_LOW,
+	MIXER_HIGH
+} MIXER_OUTPUT_t;
+
+
+// Mixer state, step 0 is a silent voice
+typedef struct
+{
+	uint16_t phase[MIXER_VOICES];
+	uint16_t step[MIXER_VOICES];            // Phase added per sample, frequency * 65536 / MIXER_SAMPLE_RATE
+	uint8_t  error;                         // Sigma-delta accumulator
+} MixerStruct;
+
+
+/*  Silence every voice
+ *  @param mixer: mixer
+ */
+void mixer_init(MixerStruct *mixer);
+
+
+/*  Returns phase step of a note
+ *  @param note: MIDI note number, 0 (and notes above MIXER_NOTE_MAX) for silence
+ */
+uint16_t mixer_note_step(uint8_t note);
+
+
+/*  Returns next output sample
+ *  @param mixer: mixer
+ *  @brief: inline, called from the sample interrupt
+ */
+static inline MIXER_OUTPUT_t mixer_sample(MixerStruct *mixer)
+{
+	uint8_t voice;
+	uint8_t active = 0, level = 0;
+
+	for (voice = 0; voice < MIXER_VOICES; voice++)
+	{
+		if (mixer->step[voice])
+		{
+			mixer->phase[voice] += mixer->step[voice];
+			level               += mixer->phase[voice] >> 15;
+			active++;
+		}
+	}
+
+	if (active == 0)
+	{
+		return MIXER_OFF;
+	}
+
+	// level out of active voices high, output is high that share of the time
+	mixer->error += level;
+
+	if (mixer->error >= active)
+	{
+		mixer->error -= active;
+		return MIXER_HIGH;
+	}
+
+	return MIXER_LOW;
+}
+
+
+#endif
@@ -0,0 +1,80 @@
+/** @file   prng.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Pseudorandom number generator
+ */
+
+#include "system.h"
+#include "prng.h"
+
+
+/*  Seed a generator
+ *  @param prng: generator
+ *  @param seed: any value, 0 is replaced by PRNG_SEED_ZERO
+ */
+void prng_seed(PrngStruct *prng, uint16_t seed)
+{
+	prng->state = seed ? seed : PRNG_SEED_ZERO;
+}
+
+
+/*  Returns next value in [1, 65535]
+ *  @param prng: generator
+ */
+uint16_t prng_next(PrngStruct *prng)
+{
+	uint16_t x = prng->state;
+
+	x ^= x << 7;
+	x ^= x >> 9;
+	x ^= x << 8;
+
+	prng->state = x;
+	return x;
+}
+
+
+/*  Returns an unbiased value in [0, bound)
+ *  @param prng: generator
+ *  @param bound: number of possible values, 0 returns 0
+ *  @brief: masks to the next power of two and rejects values past bound
+ *          instead of using %, so no division and no modulo bias
+ */
+uint8_t prng_below(PrngStruct *prng, uint8_t bound)
+{
+	uint8_t mask = bound - 1;
+	uint8_t value;
+
+	if (bound <= 1)
+	{
+		return 0;
+	}
+
+	// Smear highest set bit down, mask covers [0, bound - 1]
+	mask |= mask >> 1;
+	mask |= mask >> 2;
+	mask |= mask >> 4;
+
+	do
+	{
+		value = prng_next(prng) & mask;
+	} while (value >= bound);                     // Less than half are rejected
+
+	return value;
+}
+
+
+/*  Save/restore generator state
+ *  @param prng: generator
+ *  @param state: value returned by prng_save()
+ */
+uint16_t prng_save(const PrngStruct *prng)
+{
+	return prng->state;
+}
+
+
+void prng_restore(PrngStruct *prng, uint16_t state)
+{
+	prng_seed(prng, state);
+}
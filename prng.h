@@ -0,0 +1,56 @@
+/** @file   prng.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Pseudorandom number generator
+ *          16 bit xorshift (shifts 7, 9, 8, period 2^16 - 1): shifts and XORs
+ *          only, no multiply or divide. State lives in a caller-owned object,
+ *          so independent streams don't disturb each other and a stream can
+ *          be saved and restored to regenerate exactly the same values.
+ */
+
+#ifndef PRNG_H
+#define PRNG_H
+
+#include "system.h"
+
+#define PRNG_SEED_ZERO    0xACE1         // Used for seed 0 (the one state xorshift can't leave)
+
+
+// Generator state
+typedef struct
+{
+	uint16_t state;
+} PrngStruct;
+
+
+/*  Seed a generator
+ *  @param prng: generator
+ *  @param seed: any value, 0 is replaced by PRNG_SEED_ZERO
+ */
+void prng_seed(PrngStruct *prng, uint16_t seed);
+
+
+/*  Returns next value in [1, 65535]
+ *  @param prng: generator
+ */
+uint16_t prng_next(PrngStruct *prng);
+
+
+/*  Returns an unbiased value in [0, bound)
+ *  @param prng: generator
+ *  @param bound: number of possible values, 0 returns 0
+ *  @brief: masks to the next power of two and rejects values past bound
+ *          instead of using %, so no division and no modulo bias
+ */
+uint8_t prng_below(PrngStruct *prng, uint8_t bound);
+
+
+/*  Save/restore generator state
+ *  @param prng: generator
+ *  @param state: value returned by prng_save()
+ */
+uint16_t prng_save(const PrngStruct *prng);
+void prng_restore(PrngStruct *prng, uint16_t state);
+
+
+#endif
@@ -0,0 +1,66 @@
+/** @file   render.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Game frame renderer
+ */
+
+#include "system.h"
+#include "render.h"
+#include "board.h"
+#include "hal.h"
+
+static bool render_active = false;        // Board owns the display (not text)
+static bool render_dirty  = false;        // Board changed since last frame
+
+
+/*  Start drawing the board, the first frame is drawn on the next render_update()
+ */
+void render_start(void)
+{
+	render_active = true;
+	render_dirty  = true;
+}
+
+
+/*  Stop drawing the board and clear the display (for text to be shown)
+ */
+void render_stop(void)
+{
+	render_active = false;
+	hal_display_clear();
+}
+
+
+/*  Mark the board as changed since the last frame
+ */
+void render_invalidate(void)
+{
+	render_dirty = true;
+}
+
+
+/*  Compose wall and player layers into the back buffer and show it
+ *  @brief: does nothing unless started and the board changed since the last frame.
+ *          Every column of the back buffer is written, so the frame left in it
+ *          by the last swap never shows through
+ */
+void render_update(void)
+{
+	uint8_t *frame;
+	uint8_t x;
+
+	if (!render_active || !render_dirty)
+	{
+		return;
+	}
+
+	frame = hal_frame_back();
+
+	for (x = 0; x < BOARD_WIDTH; x++)
+	{
+		frame[x] = board_column_get(x) | board_player_column_get(x);
+	}
+
+	hal_frame_swap();
+	render_dirty = false;
+}
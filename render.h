@@ -0,0 +1,38 @@
+/** @file   render.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Game frame renderer
+ *          Walls and player are kept as separate layers on the board (board.h).
+ *          Modules only change the board and call render_invalidate(), the
+ *          layers are composed once per display tick into the back buffer,
+ *          which is then swapped in (hal_frame_swap())
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "system.h"
+
+
+/*  Start drawing the board, the first frame is drawn on the next render_update()
+ */
+void render_start(void);
+
+
+/*  Stop drawing the board and clear the display (for text to be shown)
+ */
+void render_stop(void);
+
+
+/*  Mark the board as changed since the last frame
+ */
+void render_invalidate(void);
+
+
+/*  Compose wall and player layers into the back buffer and show it
+ *  @brief: does nothing unless started and the board changed since the last frame
+ */
+void render_update(void);
+
+
+#endif
@@ -0,0 +1,228 @@
+/** @file   replay.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Input replay recorder and playback
+ */
+
+#include "system.h"
+#include "replay.h"
+#include "input.h"
+#include "hal.h"
+#include "storage.h"
+#include <stddef.h>
+
+
+typedef enum
+{
+	REPLAY_IDLE,
+	REPLAY_RECORDING,
+	REPLAY_PLAYING
+} REPLAY_STATE_t;
+
+
+// A replay as it is stored in EEPROM, header then event bytes
+typedef struct
+{
+	ReplayHeaderStruct header;
+	uint8_t            events[REPLAY_BUFFER_SIZE];
+} ReplayBufferStruct;
+
+
+// Two buffers: a game is recorded into the one not holding the stored replay,
+// which may still be being written to EEPROM from
+static ReplayBufferStruct buffers[2];
+static ReplayBufferStruct *replay = &buffers[0];   // Being recorded or played
+static ReplayBufferStruct *stored = NULL;          // Same as the EEPROM replay, NULL until known
+static REPLAY_STATE_t     state   = REPLAY_IDLE;
+static uint16_t           tick;              // Game ticks since the start
+static uint16_t           event_tick;        // Tick of the last event recorded / next event played
+static uint8_t            event_input;       // Input of the next event played, REPLAY_SKIP after the last
+static uint8_t            position;          // Next byte of events to play
+
+
+/*  Appends an event, stops recording if it doesn't fit
+ *  @param delta: ticks since the previous event
+ *  @brief: gaps over REPLAY_DELTA_MAX are bridged by REPLAY_SKIP bytes first
+ */
+static void event_add(uint16_t delta, uint8_t input)
+{
+	uint8_t length = replay->header.length;
+
+	while (!replay->header.truncated && (delta > REPLAY_DELTA_MAX) && (length < REPLAY_BUFFER_SIZE))
+	{
+		uint8_t count = (delta / REPLAY_SKIP_TICKS > REPLAY_DELTA_MAX) ? REPLAY_DELTA_MAX : delta / REPLAY_SKIP_TICKS;
+
+		replay->events[length++] = (count << REPLAY_INPUT_BITS) | REPLAY_SKIP;
+		delta                   -= count * REPLAY_SKIP_TICKS;
+	}
+
+	if (replay->header.truncated || (length == REPLAY_BUFFER_SIZE))
+	{
+		replay->header.truncated = true; // Partly written skips are dropped
+		return;
+	}
+
+	replay->events[length++] = (delta << REPLAY_INPUT_BITS) | input;
+	replay->header.length    = length;
+}
+
+
+/*  Decodes the next event to play into event_tick and event_input
+ */
+static void event_next(void)
+{
+	event_input = REPLAY_SKIP;
+
+	while (position < replay->header.length)
+	{
+		uint8_t byte  = replay->events[position++];
+		uint8_t delta = byte >> REPLAY_INPUT_BITS;
+
+		if ((byte & REPLAY_INPUT_MASK) == REPLAY_SKIP)
+		{
+			event_tick += delta * REPLAY_SKIP_TICKS;
+			continue;
+		}
+
+		event_tick += delta;
+		event_input = byte & REPLAY_INPUT_MASK;
+		return;
+	}
+}
+
+
+/*  Start recording a game
+ *  @param seed: wall seed of the game, mode: GAMEMODES_t
+ *  @brief: Call when the game starts, ticks are counted from the next replay_update().
+ *          Never waits for the EEPROM: the stored replay's buffer is left alone,
+ *          the game isn't recorded in the unlikely case the other one is still
+ *          being written (two GAME OVERs within one replay write)
+ */
+void replay_record(uint16_t seed, uint8_t mode)
+{
+	replay = (stored == &buffers[0]) ? &buffers[1] : &buffers[0];
+
+	if (storage_queued_p(replay, sizeof(*replay)))
+	{
+		state = REPLAY_IDLE;
+		return;
+	}
+
+	replay->header = (ReplayHeaderStruct){
+		.magic = REPLAY_MAGIC, .mode = mode, .seed = seed
+	};
+	tick       = 0;
+	event_tick = 0;
+	state      = REPLAY_RECORDING;
+}
+
+
+/*  Load the stored replay and start playing it
+ *  @return false if no replay is stored
+ *  @brief: EEPROM is only read the first time, after that the stored replay
+ *          is still in its buffer (even while it is being written)
+ */
+bool replay_play(void)
+{
+	if (stored == NULL)
+	{
+		replay = &buffers[0];
+		hal_eeprom_read(REPLAY_EEPROM_ADDRESS, &replay->header, sizeof(replay->header));
+
+		if ((replay->header.magic != REPLAY_MAGIC) || (replay->header.length > REPLAY_BUFFER_SIZE))
+		{
+			state = REPLAY_IDLE;
+			return false;
+		}
+
+		hal_eeprom_read(REPLAY_EEPROM_ADDRESS + sizeof(replay->header), replay->events, replay->header.length);
+		stored = replay;
+	}
+
+	replay     = stored;
+	tick       = 0;
+	event_tick = 0;
+	position   = 0;
+	state      = REPLAY_PLAYING;
+	event_next();
+	return true;
+}
+
+
+/*  Seed and gamemode of the replay playing
+ */
+uint16_t replay_seed(void)
+{
+	return replay->header.seed;
+}
+
+
+uint8_t replay_mode(void)
+{
+	return replay->header.mode;
+}
+
+
+/*  Returns true while a replay is playing
+ */
+bool replay_playing_p(void)
+{
+	return state == REPLAY_PLAYING;
+}
+
+
+/*  Record this game tick's presses, or replace them with the replay's
+ *  @brief: call once per game tick straight after input_update()
+ */
+void replay_update(void)
+{
+	uint8_t input, presses = 0;
+
+	switch (state)
+	{
+	case REPLAY_RECORDING:
+		presses = input_snapshot()->presses;
+
+		for (input = INPUT_NORTH; input <= INPUT_BUTTON; input++)
+		{
+			if (presses & BIT(input))
+			{
+				event_add(tick - event_tick, input);
+				event_tick = tick;
+			}
+		}
+		break;
+
+	case REPLAY_PLAYING:
+		while ((event_input != REPLAY_SKIP) && (event_tick == tick))
+		{
+			presses |= BIT(event_input);
+			event_next();
+		}
+
+		input_presses_set(presses);
+		break;
+
+	case REPLAY_IDLE:
+	default:
+		return;
+	}
+
+	tick++;
+}
+
+
+/*  End of the game, a recording is stored in EEPROM and playback stops
+ *  @brief: the write is queued (storage.h) as one block, only bytes that
+ *          changed are written. If the queue is full the last replay is kept
+ */
+void replay_stop(void)
+{
+	if ((state == REPLAY_RECORDING) &&
+	    storage_write(REPLAY_EEPROM_ADDRESS, replay, sizeof(replay->header) + replay->header.length))
+	{
+		stored = replay;
+	}
+
+	state = REPLAY_IDLE;
+}
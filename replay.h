@@ -0,0 +1,89 @@
+/** @file   replay.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Input replay recorder and playback
+ *          A game is fully decided by the wall seed, the gamemode and the
+ *          presses of every game tick (input_update() snapshots): walls and
+ *          difficulty step at fixed points of the task schedule and never read
+ *          the clock. Every game is recorded as its seed and gamemode followed
+ *          by delta-encoded (game tick, input) events in a RAM buffer, which is
+ *          queued to be written to EEPROM at GAME OVER (replacing the last game's).
+ *          There are two buffers, so the next game is recorded while the last
+ *          one is still being written, and playing it needs no EEPROM read.
+ *          Playback loads it back and replaces the snapshot of each game tick
+ *          with the recorded presses, so the game plays out bit-exactly on the
+ *          board and on the host (game-host -e with the board's EEPROM).
+ *
+ *  Event byte: ticks since the previous event in the top 5 bits, HAL_INPUT_t
+ *  in the low 3. Input REPLAY_SKIP only advances the tick by delta * 32, so
+ *  idle time costs a byte per ~10 s and a press costs one or two bytes.
+ *  Recording stops when the buffer is full, a truncated replay plays without
+ *  input after its last event.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "system.h"
+
+#define REPLAY_BUFFER_SIZE       128                // Event bytes of a replay (RAM and EEPROM)
+#define REPLAY_EEPROM_ADDRESS    0                  // Header, then the event bytes
+#define REPLAY_MAGIC             0xA7               // Change when the rules change, old replays won't load
+
+#define REPLAY_INPUT_BITS        3
+#define REPLAY_INPUT_MASK        (BIT(REPLAY_INPUT_BITS) - 1)
+#define REPLAY_DELTA_MAX         (0xFF >> REPLAY_INPUT_BITS)
+#define REPLAY_SKIP              REPLAY_INPUT_MASK  // Not a HAL_INPUT_t
+#define REPLAY_SKIP_TICKS        (REPLAY_DELTA_MAX + 1)
+
+
+// Stored before the event bytes, same layout on the board and the host
+typedef struct
+{
+	uint16_t seed;                   // Passed to wall_init()
+	uint8_t  magic;                  // REPLAY_MAGIC if a replay is stored
+	uint8_t  mode      : 2;          // GAMEMODES_t
+	uint8_t  truncated : 1;          // Buffer filled before GAME OVER
+	uint8_t  length;                 // Event bytes
+	uint8_t  reserved;               // Pads to an even size (host alignment)
+} ReplayHeaderStruct;
+
+
+/*  Start recording a game
+ *  @param seed: wall seed of the game, mode: GAMEMODES_t
+ *  @brief: Call when the game starts, ticks are counted from the next replay_update()
+ */
+void replay_record(uint16_t seed, uint8_t mode);
+
+
+/*  Load the stored replay and start playing it
+ *  @return false if no replay is stored
+ *  @brief: The game is then started with replay_seed() and replay_mode()
+ */
+bool replay_play(void);
+
+
+/*  Seed and gamemode of the replay playing
+ */
+uint16_t replay_seed(void);
+uint8_t replay_mode(void);
+
+
+/*  Returns true while a replay is playing
+ */
+bool replay_playing_p(void);
+
+
+/*  Record this game tick's presses, or replace them with the replay's
+ *  @brief: call once per game tick straight after input_update(),
+ *          does nothing unless recording or playing
+ */
+void replay_update(void);
+
+
+/*  End of the game, a recording is stored in EEPROM and playback stops
+ */
+void replay_stop(void);
+
+
+#endif
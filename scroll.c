@@ -0,0 +1,241 @@
+/** @file   scroll.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Scrolling of the fixed messages
+ */
+
+#include "system.h"
+#include "scroll.h"
+#include "hal.h"
+#include <avr/pgmspace.h>
+#include "text_table.h"
+
+#ifndef __AVR__
+#include <stdio.h>
+#endif
+
+#define SCROLL_PARTS    4                  // END_PROMPT, score, BEST_PROMPT, best
+
+
+// Part of the scroll, a message or a number followed by a blank character
+typedef struct
+{
+	uint16_t start;                             // TEXT_LINES index of a message
+	uint8_t  length;                            // Lines
+	uint8_t  message;                           // MESSAGE_t, NUM_MESSAGES for a number
+	uint8_t  digits[SCROLL_SCORE_DIGITS];       // Number, most significant digit first
+} ScrollPartStruct;
+
+
+// Scroll state
+static bool             scroll_active = false;
+static bool             scroll_dirty  = false;      // Frame must be drawn on the next update
+static ScrollPartStruct parts[SCROLL_PARTS];
+static uint8_t          num_parts     = 0;
+static uint8_t          scroll_length;              // Lines before the scroll repeats
+static uint8_t          position;                   // Line shown on the first display row
+static uint16_t         wait;                       // Updates until the next line
+static uint16_t         period        = 1;          // Updates per line
+
+
+/*  Returns a line of the scroll
+ *  @param index: line, the scroll repeats every scroll_length lines
+ */
+static uint8_t line_get(uint16_t index)
+{
+	const ScrollPartStruct *part = parts;
+	uint8_t                digit;
+
+	index %= scroll_length;
+
+	while (index >= part->length)
+	{
+		index -= part->length;
+		part++;
+	}
+
+	if (part->message != NUM_MESSAGES)
+	{
+		return pgm_read_byte(&TEXT_LINES[part->start + index]);
+	}
+
+	digit = index / SCROLL_GLYPH_LINES;
+
+	return (digit + 1 < part->length / SCROLL_GLYPH_LINES) ? pgm_read_byte(&TEXT_DIGIT_LINES[part->digits[digit]][index % SCROLL_GLYPH_LINES]) : 0;
+}
+
+
+/*  Append a message to the scroll
+ */
+static void part_message(MESSAGE_t message)
+{
+	ScrollPartStruct *part = &parts[num_parts++];
+
+	part->message = message;
+	part->start   = pgm_read_word(&TEXT_STARTS[message]);
+	part->length  = pgm_read_word(&TEXT_STARTS[message + 1]) - part->start;
+}
+
+
+/*  Append a number and a blank character to the scroll
+ */
+static void part_number(uint8_t number)
+{
+	ScrollPartStruct *part      = &parts[num_parts++];
+	uint8_t          num_digits = (number >= 100) ? 3 : (number >= 10) ? 2 : 1;
+	uint8_t          digit;
+
+	part->message = NUM_MESSAGES;
+	part->length  = (num_digits + 1) * SCROLL_GLYPH_LINES;
+
+	for (digit = num_digits; digit > 0; digit--)
+	{
+		part->digits[digit - 1] = number % 10;
+		number                 /= 10;
+	}
+}
+
+
+/*  Start scrolling from the first line of the parts
+ */
+static void scroll_start(void)
+{
+	uint8_t index;
+
+	scroll_length = 0;
+
+	for (index = 0; index < num_parts; index++)
+	{
+		scroll_length += parts[index].length;
+	}
+
+	position      = 0;
+	wait          = period;
+	scroll_active = true;
+	scroll_dirty  = true;
+}
+
+
+/*  Initialise scrolling
+ *  @param message_rate: characters per 10 seconds (same as tinygl_text_speed_set())
+ *  @param update_rate: rate scroll_update() is called in hz
+ */
+void scroll_init(uint8_t message_rate, uint16_t update_rate)
+{
+	period = (uint32_t)update_rate * 10 / ((uint16_t)message_rate * SCROLL_GLYPH_LINES);
+	period = period ? period : 1;
+}
+
+
+/*  Scroll a message over and over, replacing any message scrolling
+ *  @param message: message to show
+ */
+void scroll_message(MESSAGE_t message)
+{
+	num_parts = 0;
+	part_message(message);
+	scroll_start();
+}
+
+
+/*  Scroll END_PROMPT followed by the score and the best score
+ *  @param score, best: digits are appended at runtime
+ */
+void scroll_score(uint8_t score, uint8_t best)
+{
+	num_parts = 0;
+	part_message(MESSAGE_END_PROMPT);
+	part_number(score);
+	part_message(MESSAGE_BEST_PROMPT);
+	part_number(best);
+	scroll_start();
+}
+
+
+/*  Stop scrolling, the display is left as it is (for the board to be drawn)
+ */
+void scroll_stop(void)
+{
+	scroll_active = false;
+}
+
+
+/*  Advance the scroll and show the new frame
+ *  @brief: line position is on the top row and the text moves up, the same
+ *          way tinygl scrolls rotated text
+ */
+void scroll_update(void)
+{
+	uint8_t *frame;
+	uint8_t x, y;
+
+	if (!scroll_active)
+	{
+		return;
+	}
+
+	if (--wait == 0)
+	{
+		wait         = period;
+		position     = (position + 1 < scroll_length) ? position + 1 : 0;
+		scroll_dirty = true;
+	}
+
+	if (!scroll_dirty)
+	{
+		return;
+	}
+
+	frame = hal_frame_back();
+
+	for (x = 0; x < HAL_DISPLAY_WIDTH; x++)
+	{
+		frame[x] = 0;
+	}
+
+	for (y = 0; y < HAL_DISPLAY_HEIGHT; y++)
+	{
+		uint8_t line = line_get(position + y);
+
+		for (x = 0; x < HAL_DISPLAY_WIDTH; x++)
+		{
+			frame[x] |= ((line >> x) & 1) << y;
+		}
+	}
+
+	hal_frame_swap();
+	scroll_dirty = false;
+}
+
+
+#ifndef __AVR__
+/*  Returns text of the message scrolling, empty while stopped (host builds only)
+ */
+const char *scroll_text(void)
+{
+	static char text[64];
+	uint8_t     index, digit;
+	int         length = 0;
+
+	text[0] = '\0';
+
+	for (index = 0; scroll_active && (index < num_parts); index++)
+	{
+		const ScrollPartStruct *part = &parts[index];
+
+		if (part->message != NUM_MESSAGES)
+		{
+			length += snprintf(text + length, sizeof(text) - length, "%s", TEXT_STRINGS[part->message]);
+			continue;
+		}
+
+		for (digit = 0; digit + 1 < part->length / SCROLL_GLYPH_LINES; digit++)
+		{
+			length += snprintf(text + length, sizeof(text) - length, "%u", part->digits[digit]);
+		}
+		length += snprintf(text + length, sizeof(text) - length, " ");
+	}
+
+	return text;
+}
+#endif
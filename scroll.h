@@ -0,0 +1,72 @@
+/** @file   scroll.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Scrolling of the fixed messages
+ *          Every message is pre-rendered at build time (host/textgen writes
+ *          text_table.h) into scroll lines in flash, one byte per line of the
+ *          display (bit n = column n). Scrolling copies lines straight into
+ *          the display's back buffer, only the score digits are looked up
+ *          while it runs. Text reads with the board turned 90 degrees
+ *          clockwise, like tinygl's TINYGL_TEXT_DIR_ROTATE.
+ */
+
+#ifndef SCROLL_H
+#define SCROLL_H
+
+#include "system.h"
+
+#define SCROLL_GLYPH_LINES    4          // Lines per character (3x5 font and a blank line)
+#define SCROLL_SCORE_DIGITS   3          // Digits of a uint8_t score
+
+
+// Fixed messages, strings are in game_manager.h
+typedef enum
+{
+	MESSAGE_GAME_MODE_PROMPT,
+	MESSAGE_HARD_MODE,
+	MESSAGE_THREE_LIVES,
+	MESSAGE_WALL_PUSH,
+	MESSAGE_END_PROMPT,
+	MESSAGE_BEST_PROMPT,
+	NUM_MESSAGES
+} MESSAGE_t;
+
+
+/*  Initialise scrolling
+ *  @param message_rate: characters per 10 seconds (same as tinygl_text_speed_set())
+ *  @param update_rate: rate scroll_update() is called in hz
+ */
+void scroll_init(uint8_t message_rate, uint16_t update_rate);
+
+
+/*  Scroll a message over and over, replacing any message scrolling
+ *  @param message: message to show
+ */
+void scroll_message(MESSAGE_t message);
+
+
+/*  Scroll END_PROMPT followed by the score and the best score
+ *  @param score, best: digits are appended at runtime
+ */
+void scroll_score(uint8_t score, uint8_t best);
+
+
+/*  Stop scrolling, the display is left as it is (for the board to be drawn)
+ */
+void scroll_stop(void);
+
+
+/*  Advance the scroll and show the new frame
+ *  @brief: call at update_rate, does nothing while stopped
+ */
+void scroll_update(void);
+
+
+#ifndef __AVR__
+/*  Returns text of the message scrolling, empty while stopped (host builds only)
+ */
+const char *scroll_text(void);
+#endif
+
+
+#endif
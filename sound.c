@@ -6,72 +6,116 @@
 
 #include "system.h"
 #include "sound.h"
-#include "../../extra/tweeter.h"
-#include "../../extra/mmelody.h"
-#include "pio.h"
+#include "hal.h"
+#include <avr/pgmspace.h>
+
+// Note stream player of one voice
+typedef struct
+{
+	const uint8_t *start;              // First (note, ticks) pair of current stream
+	const uint8_t *next;               // Next pair to play, NULL when stopped
+	uint8_t       velocity;
+	uint8_t       ticks_left;          // sound_update() calls until next pair
+	uint8_t       priority;            // Effect priority, only used by SOUND_EFFECT_VOICE
+} SoundVoiceStruct;
 
-// Speaker objects
-static tweeter_scale_t scale_table[] = TWEETER_SCALE_TABLE(TWEETER_SWITCH_RATE); // Initialize required PWM for notes
-static tweeter_t       tweeter;
-static tweeter_obj_t   tweeter_info;
 
-// Melody objects
-static mmelody_t     melody;
-static mmelody_obj_t melody_info;
+static SoundVoiceStruct voices[HAL_VOICES];
 
 
 /* Initialisation for sound module
- * @param uint16_t rate melody task updates in hz
- * @brief: Initializes tweeter and melody objects
+ * @brief: Initializes speaker tone generator (see hal_tone_set())
  */
-void sound_init(uint16_t tune_task_rate)
+void sound_init(void)
 {
-	// Speaker object init
-	tweeter = tweeter_init(&tweeter_info, TWEETER_SWITCH_RATE, scale_table);
+	hal_tone_init();
+}
 
-	//Speaker pins init
-	pio_config_set(SPEAKER_PIN1, PIO_OUTPUT_LOW);
-	pio_config_set(SPEAKER_PIN2, PIO_OUTPUT_LOW);
 
-	// Melody object init
-	melody = mmelody_init(&melody_info, tune_task_rate,
-	                      (mmelody_callback_t)tweeter_note_play, tweeter);
-	mmelody_speed_set(melody, MELODY_BPM_DEFAULT);
+/* Advance the stream of one voice
+ * @param voice: HAL voice the stream plays on
+ * @brief: Counts down the current note, then reads the next
+ *         (note, ticks) pair from flash
+ */
+static void voice_update(uint8_t voice)
+{
+	SoundVoiceStruct *player = &voices[voice];
+	uint8_t          note, ticks;
+
+	if ((player->next == NULL) || (--player->ticks_left > 0))
+	{
+		return;
+	}
+
+	note  = pgm_read_byte(player->next);
+	ticks = pgm_read_byte(player->next + 1);
+
+	if (ticks == 0)                          // End of stream
+	{
+		if (note != SOUND_LOOP)
+		{
+			player->next = NULL;
+			hal_tone_set(voice, SOUND_REST);
+			return;
+		}
+
+		player->next = player->start;
+		note         = pgm_read_byte(player->next);
+		ticks        = pgm_read_byte(player->next + 1);
+	}
+
+	hal_tone_set(voice, player->velocity ? note : SOUND_REST);    // Square wave has no volume, velocity 0 mutes
+	player->ticks_left = ticks;
+	player->next      += 2;
 }
 
 
-/* Toggle piezo speaker
- * @brief: Switches high/low states on the pins
- * to implement a push/pull polling method
+/* Advance the current melody and sound effect
  */
-static void toggle_speaker(bool state)
+void sound_update(void)
 {
-	pio_output_set(SPEAKER_PIN1, state);
-	pio_output_set(SPEAKER_PIN2, !state);
+	voice_update(SOUND_MUSIC_VOICE);
+	voice_update(SOUND_EFFECT_VOICE);
 }
 
 
-/* Get required speaker state (on/off)
- * and toggle speaker accordingly
- */
-void speaker_update()
+/* Start a note stream on a voice
+ * @brief: First note starts on the next sound_update() */
+static void voice_play(uint8_t voice, const uint8_t stream[])
 {
-	bool state = tweeter_update(tweeter);
+	SoundVoiceStruct *player = &voices[voice];
 
-	toggle_speaker(state);
+	player->velocity   = pgm_read_byte(stream);
+	player->start      = stream + 1;
+	player->next       = player->start;
+	player->ticks_left = 1;
 }
 
 
-/* Advance the current melody */
-void sound_update()
+/* Play a song
+ * @param song: note stream in flash (PROGMEM), see sound.h
+ * @brief: First note starts on the next sound_update() */
+void sound_play(const uint8_t song[])
 {
-	mmelody_update(melody);
+	voice_play(SOUND_MUSIC_VOICE, song);
 }
 
 
-/* Play a song
- * @param song: char array containing song to play in mmelody notation */
-void sound_play(char song[])
+/* Play a sound effect over the music
+ * @param effect: note stream in flash (PROGMEM), see sound.h
+ * @param priority: an effect still playing is only cut off by one of the same or higher priority
+ * @return false if the effect was dropped
+ */
+bool sound_effect_play(const uint8_t effect[], uint8_t priority)
 {
-	mmelody_play(melody, song);
+	SoundVoiceStruct *player = &voices[SOUND_EFFECT_VOICE];
+
+	if ((player->next != NULL) && (priority < player->priority))
+	{
+		return false;
+	}
+
+	player->priority = priority;
+	voice_play(SOUND_EFFECT_VOICE, effect);
+	return true;
 }
@@ -8,37 +8,49 @@
 #define SOUND_H
 
 #include "system.h"
-#include "../../extra/tweeter.h"
-
-// Pins for speaker to plug into
-#define SPEAKER_PIN1           PIO_DEFINE(PORT_D, 4) // Pin 1
-#define SPEAKER_PIN2           PIO_DEFINE(PORT_D, 6) // Pin 3
 
 // Music constants
-#define TWEETER_SWITCH_RATE    5000                  // Rate speaker polls in hz
+#define SOUND_UPDATE_RATE      100                   // Rate sound_update() is called in hz
 #define MELODY_BPM_DEFAULT     200                   //Default music speed
 
-
-/* Initialisation for sound module
- * @param uint16_t rate melody task updates in hz
- * @brief: Initializes tweeter and melody objects
+/* Note streams (sounds/NAME.notes, generated from sounds/NAME.mmel by host/mmel2notes)
+ * Stored in flash as: velocity, then (note, ticks) pairs.
+ * ticks is the note length in sound_update() calls, note SOUND_REST is silence.
+ * A pair with 0 ticks ends the stream, its note is SOUND_LOOP or SOUND_END
  */
-void sound_init(uint16_t tune_task_rate);
+#define SOUND_REST             0
+#define SOUND_END              0
+#define SOUND_LOOP             1
+
+// Voices, music and sound effects are mixed (see mixer.h)
+#define SOUND_MUSIC_VOICE      0
+#define SOUND_EFFECT_VOICE     1
 
+// Sound effect priorities, higher cuts off lower
+#define SOUND_PRIORITY_SCORE   1
+#define SOUND_PRIORITY_HIT     2
 
-/* Get required speaker state (on/off)
- * and toggle speaker accordingly
+
+/* Initialisation for sound module
+ * @brief: Initializes speaker tone generator (see hal_tone_set())
  */
-void speaker_update(void);
+void sound_init(void);
 
 
-/* Advance the current melody */
+/* Advance the current melody and sound effect */
 void sound_update(void);
 
 
 /* Play a song
- * @param song: char array containing song to play in mmelody notation */
-void sound_play(char song[]);
+ * @param song: note stream in flash (PROGMEM), see above */
+void sound_play(const uint8_t song[]);
+
+
+/* Play a sound effect over the music
+ * @param effect: note stream in flash (PROGMEM), see above
+ * @param priority: an effect still playing is only cut off by one of the same or higher priority
+ * @return false if the effect was dropped */
+bool sound_effect_play(const uint8_t effect[], uint8_t priority);
 
 
 #endif
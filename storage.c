@@ -0,0 +1,109 @@
+/** @file   storage.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Asynchronous EEPROM writes
+ */
+
+#include "system.h"
+#include "storage.h"
+#include "hal.h"
+
+
+// Block waiting to be written, advanced a byte at a time
+typedef struct
+{
+	uint16_t      address;
+	const uint8_t *data;
+	uint8_t       length;
+} StorageBlockStruct;
+
+
+static StorageBlockStruct queue[STORAGE_QUEUE_SIZE];
+static uint8_t            head  = 0;              // Block being written
+static uint8_t            count = 0;              // Blocks queued
+
+
+/*  Queue a block to be written
+ *  @return false if the queue is full (nothing is written)
+ */
+bool storage_write(uint16_t address, const void *data, uint8_t length)
+{
+	if (count == STORAGE_QUEUE_SIZE)
+	{
+		return false;
+	}
+
+	queue[(head + count++) % STORAGE_QUEUE_SIZE] = (StorageBlockStruct){
+		.address = address, .data = data, .length = length
+	};
+	return true;
+}
+
+
+/*  Write the next changed byte if the EEPROM is ready
+ *  @brief: unchanged bytes are skipped in the same call (reads are fast),
+ *          a block is done once its last byte is written or skipped
+ */
+void storage_update(void)
+{
+	StorageBlockStruct *block = &queue[head];
+
+	if ((count == 0) || !hal_eeprom_ready_p())
+	{
+		return;
+	}
+
+	while (block->length > 0)
+	{
+		uint8_t value = *block->data++;
+		uint8_t stored;
+
+		hal_eeprom_read(block->address, &stored, 1);
+		block->length--;
+
+		if (stored != value)
+		{
+			hal_eeprom_write_byte(block->address++, value);
+			break;
+		}
+
+		block->address++;
+	}
+
+	if (block->length == 0)
+	{
+		head = (head + 1) % STORAGE_QUEUE_SIZE;
+		count--;
+	}
+}
+
+
+/*  Returns true while blocks are waiting to be written
+ */
+bool storage_busy_p(void)
+{
+	return count > 0;
+}
+
+
+/*  Returns true while a queued block still reads from a buffer
+ *  @param data, length: the buffer
+ *  @brief: a block's data pointer moves through the caller's buffer as it is written
+ */
+bool storage_queued_p(const void *data, uint16_t length)
+{
+	const uint8_t *start = data;
+	uint8_t       index;
+
+	for (index = 0; index < count; index++)
+	{
+		const StorageBlockStruct *block = &queue[(head + index) % STORAGE_QUEUE_SIZE];
+
+		if ((block->data >= start) && (block->data < start + length))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
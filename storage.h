@@ -0,0 +1,49 @@
+/** @file   storage.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Asynchronous EEPROM writes
+ *          An EEPROM byte takes about 3.3 ms to write, so blocks are queued and
+ *          storage_update() writes at most one byte per game tick, when the
+ *          previous write has finished. No task ever waits for the EEPROM.
+ *          Bytes that already hold the right value are skipped (no wear).
+ *          The caller's buffer is written from directly, it must not change
+ *          while storage_queued_p() is true for it.
+ *
+ *  EEPROM layout: replay (replay.h) at 0, high-score log (highscore.h) at 256
+ */
+
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include "system.h"
+
+#define STORAGE_QUEUE_SIZE    4          // Blocks waiting to be written
+
+
+/*  Queue a block to be written
+ *  @param address: EEPROM address of the first byte
+ *  @param data: bytes to write, read as they are written
+ *  @param length: bytes
+ *  @return false if the queue is full (nothing is written)
+ */
+bool storage_write(uint16_t address, const void *data, uint8_t length);
+
+
+/*  Write the next changed byte if the EEPROM is ready
+ *  @brief: call once per game tick
+ */
+void storage_update(void);
+
+
+/*  Returns true while blocks are waiting to be written
+ */
+bool storage_busy_p(void);
+
+
+/*  Returns true while a queued block still reads from a buffer
+ *  @param data, length: the buffer
+ */
+bool storage_queued_p(const void *data, uint16_t length);
+
+
+#endif
@@ -0,0 +1,93 @@
+/** @file   task_stats.c
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Scheduler instrumentation
+ */
+
+#include <string.h>
+#include "system.h"
+#include "task_stats.h"
+#include "uint8toa.h"
+
+#ifdef TASK_STATS_ENABLED
+static TaskStatsStruct stats[TASK_STATS_MAX];
+
+
+/*  Clears statistics of all tasks
+ */
+void task_stats_reset(void)
+{
+	memset(stats, 0, sizeof(stats));
+}
+
+
+/*  Record one task run (called by hal_run())
+ *  @param index: task table index
+ *  @param period: task period in ticks
+ *  @param late: ticks between task being due and starting
+ *  @param run: ticks the task ran for
+ */
+void task_stats_record(uint8_t index, task_tick_t period, task_tick_t late, task_tick_t run)
+{
+	TaskStatsStruct *task;
+
+	if (index >= TASK_STATS_MAX)
+	{
+		return;
+	}
+	task = &stats[index];
+
+	if (task->runs == 0)
+	{
+		task->run_min  = run;
+		task->late_min = late;
+	}
+
+	task->runs++;
+	task->run_total += run;
+	task->run_min    = (run < task->run_min) ? run : task->run_min;
+	task->run_max    = (run > task->run_max) ? run : task->run_max;
+	task->late_min   = (late < task->late_min) ? late : task->late_min;
+	task->late_max   = (late > task->late_max) ? late : task->late_max;
+
+	if (late >= period)
+	{
+		task->missed++;
+	}
+}
+
+
+/*  Returns statistics of a task, NULL if index is not tracked
+ *  @param index: task table index
+ */
+const TaskStatsStruct *task_stats_get(uint8_t index)
+{
+	return (index < TASK_STATS_MAX) ? &stats[index] : NULL;
+}
+
+
+/*  Writes " <index>:<max run>/<missed>" of one task for the debug screen
+ *  @param index: task table index
+ *  @param text: buffer of at least TASK_STATS_TEXT_SIZE chars
+ *  @return false (and text empty) if the task isn't tracked or hasn't run
+ *  @brief: Values above 255 are shown as 255
+ */
+bool task_stats_text(uint8_t index, char *text)
+{
+	*text = '\0';
+
+	if ((index >= TASK_STATS_MAX) || (stats[index].runs == 0))
+	{
+		return false;
+	}
+
+	*text++ = ' ';
+	uint8toa(index, text, false);
+	strcat(text, ":");
+	uint8toa((stats[index].run_max > UINT8_MAX) ? UINT8_MAX : stats[index].run_max, text + strlen(text), false);
+	strcat(text, "/");
+	uint8toa((stats[index].missed > UINT8_MAX) ? UINT8_MAX : stats[index].missed, text + strlen(text), false);
+
+	return true;
+}
+#endif
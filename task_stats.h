@@ -0,0 +1,83 @@
+/** @file   task_stats.h
+ *  @author Lucas Trickett, Harrison Tyson
+ *  @date   17 Oct 2026
+ *  @brief  Scheduler instrumentation
+ *          hal_run() records when each task was due, when it started and how
+ *          long it ran, all in task clock ticks (TASK_RATE per second).
+ *          On the board that is the scheduler timer, on the host the virtual
+ *          clock (where tasks take no time, so only lateness is meaningful)
+ *          The board only records in debug builds (make DEBUG=1), elsewhere
+ *          the calls compile to nothing and the table takes no SRAM.
+ *          Host builds always record (game-host prints the table)
+ */
+
+#ifndef TASK_STATS_H
+#define TASK_STATS_H
+
+#include "system.h"
+#include "task.h"
+
+#define TASK_STATS_MAX          5       // Entries of the game.c task table, later entries are ignored
+#define TASK_STATS_TEXT_SIZE    13      // " 255:255/255" and '\0'
+
+#if defined(TASK_STATS_DEBUG) || !defined(__AVR__)
+#define TASK_STATS_ENABLED
+#endif
+
+
+/* Statistics of one task table entry
+ */
+typedef struct
+{
+	uint32_t    runs;
+	uint32_t    run_total;        // Sum of run times, for the mean
+	task_tick_t run_min;
+	task_tick_t run_max;
+	task_tick_t late_min;         // Start time - due time, late_max - late_min is the jitter
+	task_tick_t late_max;
+	uint16_t    missed;           // Started after the next period was already due
+} TaskStatsStruct;
+
+
+#ifdef TASK_STATS_ENABLED
+/*  Clears statistics of all tasks
+ */
+void task_stats_reset(void);
+
+
+/*  Record one task run (called by hal_run())
+ *  @param index: task table index
+ *  @param period: task period in ticks
+ *  @param late: ticks between task being due and starting
+ *  @param run: ticks the task ran for
+ */
+void task_stats_record(uint8_t index, task_tick_t period, task_tick_t late, task_tick_t run);
+
+
+/*  Returns statistics of a task, NULL if index is not tracked
+ *  @param index: task table index
+ */
+const TaskStatsStruct *task_stats_get(uint8_t index);
+
+
+/*  Writes " <index>:<max run>/<missed>" of one task for the debug screen
+ *  @param index: task table index
+ *  @param text: buffer of at least TASK_STATS_TEXT_SIZE chars
+ *  @return false (and text empty) if the task isn't tracked or hasn't run
+ */
+bool task_stats_text(uint8_t index, char *text);
+
+#else
+static inline void task_stats_reset(void)
+{
+}
+
+
+static inline void task_stats_record(__unused__ uint8_t index, __unused__ task_tick_t period,
+                                     __unused__ task_tick_t late, __unused__ task_tick_t run)
+{
+}
+#endif
+
+
+#endif
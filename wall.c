@@ -6,188 +6,394 @@
 
 #include "system.h"
 #include "wall.h"
-#include "display.h"
-#include <stdlib.h>
+#include "board.h"
 #include "character.h"
+#include "render.h"
+#include "prng.h"
+#include "game_manager.h"
+#include "game_state.h"
+#include <avr/pgmspace.h>
+#include "wall_table.h"
 
 
-// Global variable used to store wall information
-static WallStruct active_wall;
+// Walls of the current game are part of the game state (game_state_walls_edit())
+static uint8_t max_hole_size = MAX_HOLE_SIZE;         // Tuning setting, kept across games
 
 
-/*  Initialises module
- *  @params initial_seed: uses srand() from <stdlib.h> to set initial seed
- *                        for pseudorandom number generator (PRNG)
- *   @brief: Given deterministic nature of PRNG's, seed must vary game-to-game
+#if WALL_TABLE_SIZE > 64
+#error "WallSlotStruct.variant is too small for WALL_TABLE"
+#endif
+
+
+/*  Returns number of moves until wall reaches a cell's row/column
+ *  @param wall: wall moving in a straight line
+ *  @param x: column, y: row
+ *  @param across: set to the cell's position along the wall
+ *  @return WALL_NO_IMPACT if the cell is behind the wall
  */
-void wall_init(uint8_t initial_seed)
+static uint8_t path_moves(const WallStruct *wall, uint8_t x, uint8_t y, uint8_t *across)
 {
-	srand(initial_seed);
-	// Reset wall if active wall exists (game reset)
-	active_wall.wall_type = OUT_OF_BOUNDS;
-	active_wall.bit_data  = 0;
+	uint8_t along;                 // Cell position along the wall's path
+
+	switch (wall->wall_type)
+	{
+	case ROW:
+		along   = y;
+		*across = x;
+		break;
+
+	case COLUMN:
+		along   = x;
+		*across = y;
+		break;
+
+	default:
+		*across = 0;
+		return WALL_NO_IMPACT;
+	}
+
+	// SOUTH/EAST walls count up, NORTH/WEST walls count down
+	if (wall->direction == SOUTH || wall->direction == EAST)
+	{
+		return (along >= wall->pos) ? along - wall->pos : WALL_NO_IMPACT;
+	}
+
+	return (wall->pos >= along) ? wall->pos - along : WALL_NO_IMPACT;
 }
 
 
-/*  Creates wall based on randomly generated integer inputs
- *  @params: All inputs are random uint8_t integers which seed wall direction, hole size, and hole position
- *  @brief: Each input decides a different aspect of wall
- *  @return: Randomly generated WallStruct
+/*  Returns number of moves until wall covers a cell
+ *  @param wall: wall moving in a straight line
+ *  @param x: column, y: row
+ *  @return WALL_NO_IMPACT if the cell is in the hole or behind the wall
  */
-static WallStruct decide_wall_type(uint8_t direction_seed, uint8_t hole_size_seed, uint8_t hole_shift_seed)
+static uint8_t impact_moves(const WallStruct *wall, uint8_t x, uint8_t y)
 {
-	WallStruct new_wall;
-	uint8_t    wall_bitmap;
+	uint8_t across;
+	uint8_t moves = path_moves(wall, x, y, &across);
 
-	WALL_DIRECTION_t wall_direction = (direction_seed) % NUM_OF_DIRECTIONS + 1;    // Random number in interval [1, NUM_OF_DIRECTIONS], decides wall direction
-	uint8_t          hole_size      = (hole_size_seed) % MAX_HOLE_SIZE + 1;        // Random number in interval [1, MAX_HOLE_SIZE], decides hole size
+	return (wall->bit_data & BIT(across)) ? moves : WALL_NO_IMPACT;
+}
 
-	// Randomly shift hole along the wall, must be less than (wall_size - hole_size)
-	// (e.g. if ROW and hole_size is 3, shift must be less than 6-3)
-	uint8_t wall_size  = ((wall_direction == NORTH || wall_direction == SOUTH) ? ROW_SIZE : COLUMN_SIZE) + 1;
-	uint8_t hole_shift = hole_shift_seed % (wall_size - hole_size);
 
-	// Convert hole size to binary for bitmap
-	// For better dynamic size handling a decimal to binary function will need to be implemented
-	switch (hole_size)
+/*  Recomputes impacts of every wall if the player moved since they were computed
+ */
+static void impacts_update(void)
+{
+	WallPoolStruct            *walls     = game_state_walls_edit();
+	const CharacterInfoStruct *character = get_character_info();
+	uint8_t                   index;
+
+	if (!walls->impact_stale && (character->x == walls->impact_x) && (character->y == walls->impact_y))
 	{
-	case 1:
-		hole_size = 0b1;
-		break;
+		return;
+	}
 
-	case 2:
-		hole_size = 0b11;
-		break;
+	walls->impact_x     = character->x;
+	walls->impact_y     = character->y;
+	walls->impact_stale = false;
 
-	case 3:
-		hole_size = 0b111;
-		break;
+	for (index = 0; index < WALL_POOL_SIZE; index++)
+	{
+		walls->slots[index].impact = impact_moves(&walls->slots[index].wall, walls->impact_x, walls->impact_y);
+	}
+}
 
-	default:
-		hole_size = 0b1;                         //Ensures a gap of 1 will always exist
-		break;
+
+/*  Places every live wall on the board
+ */
+static void walls_board_update(void)
+{
+	const WallPoolStruct *walls = &game_state_get()->walls;
+	uint8_t              index;
+
+	board_walls_clear();
+
+	for (index = 0; index < WALL_POOL_SIZE; index++)
+	{
+		board_wall_add(&walls->slots[index].wall);
 	}
+}
 
-	wall_bitmap = GENERATE_HOLE(hole_size, hole_shift);              // Generates wall bit_data using the random parameters
 
-	// Creates wall moving in given direction
-	switch (wall_direction)
+/*  Initialises module
+ *  @params initial_seed: uses prng_seed() to set initial seed
+ *                        for pseudorandom number generator (PRNG)
+ *   @brief: Given deterministic nature of PRNG's, seed must vary game-to-game
+ */
+void wall_init(uint16_t initial_seed)
+{
+	WallPoolStruct *walls = game_state_walls_edit();
+	uint8_t        index;
+
+	prng_seed(&walls->prng, initial_seed);
+
+	// Free every slot (game reset)
+	for (index = 0; index < WALL_POOL_SIZE; index++)
 	{
-	case NORTH:                 // NORTH moving wall, ROW
-		new_wall = (WallStruct)NORTH_MOVING_WALL(wall_bitmap);
-		break;
+		walls->slots[index].wall.wall_type = OUT_OF_BOUNDS;
+		walls->slots[index].wall.bit_data  = 0;
+	}
 
-	case EAST:                  // EAST moving wall, COLUMN
-		new_wall = (WallStruct)EAST_MOVING_WALL(wall_bitmap);
-		break;
+	walls->spawn_wait   = 0;
+	walls->impact_now   = false;
+	walls->impact_stale = true;        // Impacts are computed on the first step
+	board_walls_clear();
+	render_invalidate();
+}
 
-	case SOUTH:                 // SOUTH moving wall, ROW
-		new_wall = (WallStruct)SOUTH_MOVING_WALL(wall_bitmap);
-		break;
 
-	case WEST:                  // WEST moving wall, COLUMN
-		new_wall = (WallStruct)WEST_MOVING_WALL(wall_bitmap);
-		break;
+/*  Limits size of holes in new walls (for difficulty tuning)
+ *  @param hole_size: largest hole, clamped to [1, MAX_HOLE_SIZE]
+ */
+void wall_max_hole_size_set(uint8_t hole_size)
+{
+	max_hole_size = (hole_size < 1) ? 1 : (hole_size > MAX_HOLE_SIZE) ? MAX_HOLE_SIZE : hole_size;
+}
 
-	default:                  // East moving wall as failsafe
-		new_wall = (WallStruct)EAST_MOVING_WALL(wall_bitmap);
-		break;
+
+/*  Selects wall weighting used by wall_create()
+ *  @param mode: GAMEMODES_t of the game being started, others use THREE_LIVES weights
+ */
+void wall_weights_set(uint8_t mode)
+{
+	WallPoolStruct *walls = game_state_walls_edit();
+
+	walls->weights = (mode < DIFFERENT_GAMEMODES) ? mode : THREE_LIVES;
+}
+
+
+/*  Sets how many walls can be on the display at once
+ *  @param limit: live walls, clamped to [1, WALL_POOL_SIZE]
+ */
+void wall_limit_set(uint8_t limit)
+{
+	WallPoolStruct *walls = game_state_walls_edit();
+
+	walls->limit = (limit < 1) ? 1 : (limit > WALL_POOL_SIZE) ? WALL_POOL_SIZE : limit;
+}
+
+
+/*  Returns number of walls on the display
+ */
+uint8_t wall_count(void)
+{
+	const WallPoolStruct *walls = &game_state_get()->walls;
+	uint8_t              index, count = 0;
+
+	for (index = 0; index < WALL_POOL_SIZE; index++)
+	{
+		count += (walls->slots[index].wall.wall_type != OUT_OF_BOUNDS);
 	}
 
-	return new_wall;
+	return count;
 }
 
 
-/*  Resets and randomises active_wall
- *  @brief: starting random seed is initialised in wall_init() with srand()
- *          uses helper function decide_wall_type() to create wall
+/*  Returns true if a new wall should be created this step
+ *  @brief: walls spawn WALL_SPAWN_GAP steps apart while under the limit,
+ *          and never on the step a wall leaves the display
  */
-void wall_create(void)
+bool wall_spawn_due(void)
 {
-	// Randomly select wall-type using default seed
-	uint8_t direction_seed  = rand();
-	uint8_t hole_size_seed  = rand();
-	uint8_t hole_shift_seed = rand();
+	const WallPoolStruct *walls = &game_state_get()->walls;
+
+	return (walls->spawn_wait == 0) && (wall_count() < walls->limit);
+}
+
+
+/*  Adds a random wall to the pool
+ *  @param period: difficulty steps per move of this wall (1 = full speed, up to WALL_MAX_PERIOD)
+ *  @brief: starting random seed is initialised in wall_init() with prng_seed()
+ *          one random byte picks a slot of the gamemode's weight table, walls
+ *          with holes over max_hole_size are drawn again (wallgen fails the
+ *          build unless every max_hole_size leaves some to draw).
+ *          Does nothing if the pool is full
+ */
+void wall_create(uint8_t period)
+{
+	WallPoolStruct *walls   = game_state_walls_edit();
+	uint8_t        index;
+	uint8_t        end      = pgm_read_byte(&WALL_TABLE_HOLE_END[max_hole_size]);
+	const uint8_t  *weights = WALL_WEIGHTS[walls->weights];
+	WallSlotStruct *slot    = walls->slots;
+
+	while (slot->wall.wall_type != OUT_OF_BOUNDS)
+	{
+		if (++slot == walls->slots + WALL_POOL_SIZE)
+		{
+			return;
+		}
+	}
 
-	// Generate wall type
-	active_wall = decide_wall_type(direction_seed, hole_size_seed, hole_shift_seed);
+	do
+	{
+		index = pgm_read_byte(&weights[prng_next(&walls->prng) % WALL_WEIGHT_SLOTS]);
+	} while (index >= end);
+
+	memcpy_P(&slot->wall, &WALL_TABLE[index], sizeof(slot->wall));
+	slot->variant     = index;
+	slot->period      = (period < 1) ? 1 : (period > WALL_MAX_PERIOD) ? WALL_MAX_PERIOD : period;
+	slot->wait        = slot->period;
+	walls->spawn_wait = WALL_SPAWN_GAP;
+
+	impacts_update();
+	slot->impact       = impact_moves(&slot->wall, walls->impact_x, walls->impact_y);
+	walls->impact_now |= (slot->impact == 0);   // Spawned on top of the player
 
-	toggle_wall(true);               //Display wall
+	board_wall_add(&slot->wall);
+	render_invalidate();             //Display walls
 }
 
 
-/* Returns the current active wall as WallStruct
- * @return WallStruct active wall*/
-WallStruct get_active_wall()
+/*  Save/restore wall generator state
+ *  @param state: value returned by wall_rand_state_get()
+ *  @brief: restoring a saved state makes wall_create() repeat the same walls
+ */
+uint16_t wall_rand_state_get(void)
 {
-	return active_wall;
+	const WallPoolStruct *walls = &game_state_get()->walls;
+
+	return prng_save(&walls->prng);
 }
 
 
-/*  Toggles display state of active_wall
- *  @param display_on: if 0 = then active_wall in wall.c isn't displayed
+void wall_rand_state_set(uint16_t state)
+{
+	WallPoolStruct *walls = game_state_walls_edit();
+
+	prng_restore(&walls->prng, state);
+}
+
+
+/*  Returns true if a wall reached the player on the last step
+ *  @brief: set by move_walls() and wall_create(), check_collisions()
+ *          only needs to run when it is
  */
-void toggle_wall(bool display_on)
+bool wall_impact_p(void)
 {
-	// If display is off, pattern if 0
-	uint8_t pattern = (display_on) ? active_wall.bit_data : 0;
-	uint8_t index;
-	uint8_t position = active_wall.pos;              // Position of the wall
+	const WallPoolStruct *walls = &game_state_get()->walls;
+
+	return walls->impact_now;
+}
+
 
-	CharacterInfoStruct character = get_character_info();
+/*  Returns the live wall covering a cell
+ *  @param x: column, y: row
+ *  @return wall, NULL if the cell is empty
+ */
+const WallStruct *wall_at(uint8_t x, uint8_t y)
+{
+	const WallPoolStruct *walls = &game_state_get()->walls;
+	uint8_t              index;
 
-	switch (active_wall.wall_type)
+	for (index = 0; index < WALL_POOL_SIZE; index++)
 	{
-	// If wall_type is ROW, position is in y-axis
-	case ROW:
-		// Iterate each pixel
-		for (index = 0; index <= DISPLAY_WIDTH; index++)
+		const WallStruct *wall = &walls->slots[index].wall;
+
+		if (((wall->wall_type == ROW) && (wall->pos == y) && (wall->bit_data & BIT(x))) ||
+		    ((wall->wall_type == COLUMN) && (wall->pos == x) && (wall->bit_data & BIT(y))))
 		{
-			bool state = (BIT(index) & pattern) != 0;                                                    // Gets the index-th bit of the walls bit_data
-			if ((index != character.x) || (position != character.y))                                     // Wont display over character
-			{
-				display_pixel_set(index, position, state);                                               // display the state of each pixel in wall
-			}
+			return wall;
 		}
-		break;
+	}
 
-	// If wall_type is COLUMN, position is in x-axis
-	case COLUMN:
-		// Iterate each pixel
-		for (index = 0; index <= DISPLAY_HEIGHT; index++)
+	return NULL;
+}
+
+
+/*  Returns the shortest way out of the path of the next wall to reach a cell
+ *  @param x: column, y: row
+ *  @return WALL_ESCAPE() entry, WALL_ESCAPE_STAY if the cell is in that wall's
+ *          hole, WALL_ESCAPE_CLEAR if no wall is coming
+ *  @brief: the wall with the fewest difficulty steps until it reaches the
+ *          cell's row/column is picked (a wall already on it is passing),
+ *          its way out is read from ESCAPE_TABLE, nothing is searched
+ */
+uint8_t wall_escape(uint8_t x, uint8_t y)
+{
+	const WallPoolStruct *walls   = &game_state_get()->walls;
+	uint8_t              nearest = UINT8_MAX;
+	uint8_t              escape  = WALL_ESCAPE_CLEAR;
+	uint8_t              index, across, moves, steps;
+
+	for (index = 0; index < WALL_POOL_SIZE; index++)
+	{
+		const WallSlotStruct *slot = &walls->slots[index];
+
+		moves = path_moves(&slot->wall, x, y, &across);
+
+		if ((moves == 0) || (moves == WALL_NO_IMPACT))
 		{
-			bool state = (BIT(index) & pattern) != 0;                                                    // Gets the index-th bit of the walls bit_data
-			if ((position != character.x) || (index != character.y))                                     // Wont display over character
-			{
-				display_pixel_set(position, index, state);                                               // display the state of each pixel in wall
-			}
+			continue;
 		}
-		break;
 
-	default:
-		break;
+		steps = (moves - 1) * slot->period + slot->wait;
+
+		if (steps < nearest)
+		{
+			nearest = steps;
+			escape  = pgm_read_byte(&ESCAPE_TABLE[slot->variant][across]);
+		}
 	}
+
+	return escape;
 }
 
 
-/*  Moves active wall in direction defined by wall
- *  @brief: moves wall, sets WALL_TYPE to OUT_OF_BOUNDS is greater than active_wall.boundary_cond
+/*  Moves walls that are due this step in the direction defined by each wall
+ *  @brief: walls past their boundary_cond become OUT_OF_BOUNDS (slot is freed).
+ *          Cost is bounded by WALL_POOL_SIZE and BOARD_WIDTH, not by wall speed.
+ *          Each wall counts down the moves until it reaches the player, the
+ *          counts are only recomputed when the player has moved
+ *  @return true if any wall moved
  */
-void move_wall()
+bool move_walls(void)
 {
-	// Toggle wall display state to off before moving it
-	toggle_wall(false);
+	WallPoolStruct *walls = game_state_walls_edit();
+	uint8_t        index;
+	bool           moved  = false;
 
-	// SOUTH/EAST are positive increments NORTH/WEST are negative
-	active_wall.pos += (active_wall.direction == SOUTH || active_wall.direction == EAST) ? STEP_SIZE: -STEP_SIZE;
+	walls->spawn_wait -= (walls->spawn_wait > 0);
+	walls->impact_now  = false;
+	impacts_update();
 
-	// Positions are unsigned, thus only one boundary check is needed
-	// (as for negative moving directions pos = 0 -> 255, = above boundary)
-	if (active_wall.pos > active_wall.boundary_cond)
+	for (index = 0; index < WALL_POOL_SIZE; index++)
 	{
-		active_wall.wall_type = OUT_OF_BOUNDS;
-		return;
+		WallSlotStruct *slot = &walls->slots[index];
+
+		if ((slot->wall.wall_type == OUT_OF_BOUNDS) || (--slot->wait > 0))
+		{
+			continue;
+		}
+
+		slot->wait = slot->period;
+		moved      = true;
+
+		// Wall reaches the player on this move, it is past the player after it
+		if ((slot->impact != WALL_NO_IMPACT) && (--slot->impact == 0))
+		{
+			walls->impact_now = true;
+			slot->impact      = WALL_NO_IMPACT;
+		}
+
+		// SOUTH/EAST are positive increments NORTH/WEST are negative
+		slot->wall.pos += (slot->wall.direction == SOUTH || slot->wall.direction == EAST) ? STEP_SIZE: -STEP_SIZE;
+
+		// Positions are unsigned, thus only one boundary check is needed
+		// (as for negative moving directions pos = 0 -> 255, = above boundary)
+		if (slot->wall.pos > slot->wall.boundary_cond)
+		{
+			slot->wall.wall_type = OUT_OF_BOUNDS;
+			walls->spawn_wait    = (walls->spawn_wait > 0) ? walls->spawn_wait : 1;     // Next wall waits a step
+		}
+	}
+
+	if (moved)
+	{
+		walls_board_update();
+		render_invalidate();
 	}
 
-	toggle_wall(true);               // Won't change anything if active_wall is NULL
+	return moved;
 }
@@ -8,6 +8,7 @@
 #define WALL_H
 
 #include "system.h"
+#include "prng.h"
 
 /*  Create wall bitmap with a hole
  *  @param SIZE size of the whole in pixels eg. binary 0b00000001 to 0b00001111
@@ -27,6 +28,23 @@
 #define ROW_SIZE               LEDMAT_COLS_NUM
 #define COLUMN_SIZE            LEDMAT_ROWS_NUM
 
+// Wall pool
+#define WALL_POOL_SIZE         4      // Most walls on the display at once
+#define WALL_SPAWN_GAP         3      // Difficulty steps between wall spawns
+#define WALL_FULL_SPEED        1      // Wall period (difficulty steps per move) of the first wall
+#define WALL_CROSSING_PERIOD   2      // Wall period of walls spawned while others are live
+#define WALL_MAX_PERIOD        3      // Slowest wall period (fits WallSlotStruct.period)
+#define WALL_NO_IMPACT         7      // Impact count of a wall that never reaches the player
+
+/*  Escape table entry (see wall_escape()): shortest way out of a wall's path
+ *  @param DIRECTION: WALL_DIRECTION_t to move in, MOVES: moves to the nearest hole cell
+ */
+#define WALL_ESCAPE(DIRECTION, MOVES)    (((DIRECTION) << 4) | (MOVES))
+#define WALL_ESCAPE_DIRECTION(ENTRY)     ((ENTRY) >> 4)
+#define WALL_ESCAPE_MOVES(ENTRY)         ((ENTRY) & 0x0F)
+#define WALL_ESCAPE_STAY                 0    // In the hole
+#define WALL_ESCAPE_CLEAR                0xFF // No wall coming
+
 /* Initialisation MACROs for each wall type
  * Each entry represents starting state of each wall type
  * @param bitmap for the wall
@@ -58,42 +76,123 @@ typedef enum
  */
 typedef struct
 {
-	uint8_t          bit_data;            // eg. 0b11000111 -- (1= wall, 0=hole)
-	uint8_t          pos;                 // Current column/row
-	uint8_t          boundary_cond;       // If pos>coundary_cond for wall deletion
-	WALL_TYPE_t      wall_type;           // COLUMN/ROW/OUT_OF_BOUNDS
-	WALL_DIRECTION_t direction;           // The direction of movement of wall
+	uint8_t bit_data;                     // eg. 0b11000111 -- (1= wall, 0=hole)
+	uint8_t pos;                          // Current column/row (wraps to 255 past NORTH/WEST boundary)
+	uint8_t boundary_cond : 3;            // If pos>coundary_cond for wall deletion
+	uint8_t wall_type     : 2;            // WALL_TYPE_t, COLUMN/ROW/OUT_OF_BOUNDS
+	uint8_t direction     : 3;            // WALL_DIRECTION_t, the direction of movement of wall
 } WallStruct;
 
 
+// Pool entry, slot is free while its wall is OUT_OF_BOUNDS
+typedef struct
+{
+	WallStruct wall;
+	uint8_t    period  : 2;               // Difficulty steps per move (1 = every step)
+	uint8_t    wait    : 2;               // Steps left until next move
+	uint8_t    impact  : 3;               // Moves until the wall covers the player, WALL_NO_IMPACT if it never will
+	uint8_t    variant : 6;               // WALL_TABLE index, row of ESCAPE_TABLE (wall_table.h)
+} WallSlotStruct;
+
+
+// Walls of a game (part of GameStateStruct, see game_state.h)
+typedef struct
+{
+	WallSlotStruct slots[WALL_POOL_SIZE];
+	PrngStruct     prng;                  // Wall generator, only used by wall_create()
+	uint8_t        limit        : 3;      // Live walls allowed at once
+	uint8_t        spawn_wait   : 2;      // Steps until another wall may spawn
+	uint8_t        impact_now   : 1;      // A wall reached the player this step
+	uint8_t        weights      : 2;      // GAMEMODES_t of the weight table wall_create() uses
+	uint8_t        impact_x     : 3;      // Player cell the impacts were computed for
+	uint8_t        impact_y     : 3;
+	uint8_t        impact_stale : 1;      // Impacts must be computed on the next step
+} WallPoolStruct;
+
+
 /*  Initialises module
- *  @params initial_seed: uses srand() from <stdlib.h> to set initial seed
+ *  @params initial_seed: uses prng_seed() to set initial seed
  *    for pseudorandom number generator (PRNG)
  *  @brief: Given deterministic nature of PRNG's, seed must vary game-to-game */
-void wall_init(uint8_t initial_seed);
+void wall_init(uint16_t initial_seed);
+
+
+/*  Limits size of holes in new walls (for difficulty tuning)
+ *  @param hole_size: largest hole, clamped to [1, MAX_HOLE_SIZE]
+ */
+void wall_max_hole_size_set(uint8_t hole_size);
+
+
+/*  Selects wall weighting used by wall_create()
+ *  @param mode: GAMEMODES_t of the game being started, others use THREE_LIVES weights
+ */
+void wall_weights_set(uint8_t mode);
 
 
-/*  Resets and randomises ACTIVE_WALL
- *  @brief: starting random seed is initialised in wall_init() with srand()
- *          uses helper function decide_wall_type() to create wall
+/*  Sets how many walls can be on the display at once
+ *  @param limit: live walls, clamped to [1, WALL_POOL_SIZE]
  */
-void wall_create(void);
+void wall_limit_set(uint8_t limit);
 
 
-/* Returns the current active wall as WallStruct
- * @return WallStruct active wall*/
-WallStruct get_active_wall(void);
+/*  Returns number of walls on the display
+ */
+uint8_t wall_count(void);
 
 
-/*  Toggles display state of ACTIVE_WALL
- *  @param display_on: if 0 = then ACTIVE_WALL in wall.c isn't displayed
+/*  Returns true if a new wall should be created this step
+ *  @brief: walls spawn WALL_SPAWN_GAP steps apart while under the limit,
+ *          and never on the step a wall leaves the display
  */
-void toggle_wall(bool display_on);
+bool wall_spawn_due(void);
+
+
+/*  Adds a random wall to the pool
+ *  @param period: difficulty steps per move of this wall (1 = full speed, up to WALL_MAX_PERIOD)
+ *  @brief: starting random seed is initialised in wall_init() with prng_seed()
+ *          picks a wall from the generated table (wall_table.h, see host/wallgen.c).
+ *          Does nothing if the pool is full
+ */
+void wall_create(uint8_t period);
+
 
+/*  Save/restore wall generator state
+ *  @param state: value returned by wall_rand_state_get()
+ *  @brief: restoring a saved state makes wall_create() repeat the same walls
+ */
+uint16_t wall_rand_state_get(void);
+void wall_rand_state_set(uint16_t state);
+
+
+/*  Returns true if a wall reached the player on the last step
+ *  @brief: set by move_walls() and wall_create(), check_collisions()
+ *          only needs to run when it is
+ */
+bool wall_impact_p(void);
 
-/*  Moves active wall in direction defined by wall
- *  @brief: moves wall, sets WALL_TYPE_t to OUT_OF_BOUNDS is greater than ACTIVE_WALL.boundary_cond */
-void move_wall(void);
+
+/*  Returns the live wall covering a cell
+ *  @param x: column, y: row
+ *  @return wall, NULL if the cell is empty
+ */
+const WallStruct *wall_at(uint8_t x, uint8_t y);
+
+
+/*  Returns the shortest way out of the path of the next wall to reach a cell
+ *  @param x: column, y: row
+ *  @return WALL_ESCAPE() entry, WALL_ESCAPE_STAY if the cell is in that wall's
+ *          hole, WALL_ESCAPE_CLEAR if no wall is coming
+ *  @brief: one flash read, the ways out are generated by host/wallgen.c
+ */
+uint8_t wall_escape(uint8_t x, uint8_t y);
+
+
+/*  Moves walls that are due this step in the direction defined by each wall
+ *  @brief: walls past their boundary_cond become OUT_OF_BOUNDS (slot is freed),
+ *          wall_impact_p() tells if one of them reached the player
+ *  @return true if any wall moved
+ */
+bool move_walls(void);
 
 
 #endif